@@ -0,0 +1,199 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <limits>
+
+#include "fep_system/fep_system.h"
+
+///The default size the event journal file grows by
+#define FEP_SYSTEM_EVENT_JOURNAL_CHUNK_SIZE (16 * 1024 * 1024)
+
+namespace fep
+{
+    /**
+     * @brief One event of an event journal as read by the fep::EventJournalReader
+     */
+    struct EventJournalRecord
+    {
+        /// The kind of the event
+        enum class Type
+        {
+            /// a log or an incident
+            log,
+            /// a state change of a participant
+            state_changed,
+            /// a participant was renamed
+            name_changed
+        };
+
+        /// the kind of the event
+        Type type = Type::log;
+        /// time of the log, time the recorder received state and name changes (see EventJournalReader::getTimeResolution)
+        timestamp_t log_time = 0;
+        /// simulation time of incidents, -1 if not known
+        timestamp_t simulation_time = -1;
+        /// category of the log
+        logging::Category category = logging::CATEGORY_SYSTEM;
+        /// severity level of the log
+        logging::Severity severity_level = logging::SEVERITY_INFO;
+        /// the new state on state changes
+        rpc::IRPCStateMachine::State state = FS_UNKNOWN;
+        /// the issuing participant, the new name on name changes
+        std::string participant_name;
+        /// usually the system, participant, component or element name
+        std::string logger_name;
+        /// the message of logs, the old name on name changes
+        std::string message;
+    };
+
+    /**
+     * @brief Selects the records read by the fep::EventJournalReader
+     */
+    struct EventJournalFilter
+    {
+        /// only events of this participant (new name on name changes), empty selects all participants
+        std::string participant_name;
+        /// only events with a log time at or after this time
+        timestamp_t begin_time = std::numeric_limits<timestamp_t>::min();
+        /// only events with a log time at or before this time
+        timestamp_t end_time = std::numeric_limits<timestamp_t>::max();
+        /// only logs of this level or more severe, state and name changes are not filtered by severity
+        logging::Severity severity_level = logging::SEVERITY_DEBUG;
+        /// select state and name changes
+        bool include_state_changes = true;
+    };
+
+    /**
+     * @brief A fep::IEventMonitor appending every log, incident, state change and name change
+     * to a memory mapped binary journal file.
+     *
+     * The records are copied into the mapped file with a compact layout, no text is formatted.
+     * The file grows by @ref FEP_SYSTEM_EVENT_JOURNAL_CHUNK_SIZE and is cut to the written size on close.
+     * The end of the written records is kept in the file header after every append,
+     * so a journal of a crashed process can still be read up to the last complete record.
+     * Use the recorder with the batched delivery (see fep::MonitorBatchOptions) to write big chunks at once.
+     * Read the journal with the fep::EventJournalReader or the fep_event_journal tool.
+     */
+    class FEP_SYSTEM_EXPORT EventRecorder : public IEventMonitor
+    {
+    public:
+        /**
+         * @brief Creates the journal file, an existing file is overwritten
+         *
+         * @param file_path  the path of the journal file
+         * @param resolution the resolution the system gives the log times in (see System::setMonitoringTimeResolution),
+         *                   the recorder stamps state and name changes with it and stores it in the journal
+         * @param chunk_size the size the file grows by
+         * @throw runtime_error if the file can not be created or mapped
+         */
+        explicit EventRecorder(const std::string& file_path,
+                               MonitorTimeResolution resolution = MonitorTimeResolution::microseconds,
+                               size_t chunk_size = FEP_SYSTEM_EVENT_JOURNAL_CHUNK_SIZE);
+        /**
+         * @brief Closes the journal, unregister the recorder from all systems before
+         */
+        ~EventRecorder();
+        EventRecorder(const EventRecorder&) = delete;
+        EventRecorder& operator=(const EventRecorder&) = delete;
+
+        void onStateChanged(const std::string& participant, rpc::IRPCStateMachine::State state) override;
+        void onNameChanged(const std::string& new_name, const std::string& old_name) override;
+        void onLog(timestamp_t log_time,
+                   logging::Category category,
+                   logging::Severity severity_level,
+                   const std::string& participant_name,
+                   const std::string& logger_name,
+                   const std::string& message) override;
+        void onLogWithSimulationTime(timestamp_t log_time,
+                                     timestamp_t simulation_time,
+                                     logging::Category category,
+                                     logging::Severity severity_level,
+                                     const std::string& participant_name,
+                                     const std::string& logger_name,
+                                     const std::string& message) override;
+        void onLogBatch(const std::vector<std::shared_ptr<const MonitorLogRecord>>& records) override;
+        void onStateChangedBatch(const std::vector<MonitorStateRecord>& records) override;
+
+        /**
+         * @brief Writes the mapped pages to the file (the records are readable from the file without that)
+         */
+        void flush();
+
+        /**
+         * @brief Cuts the file to the written records and unmaps it, later events are not recorded
+         */
+        void close();
+
+        /**
+         * @brief The count of records written so far
+         */
+        size_t getRecordCount() const;
+
+    private:
+        struct Implementation;
+        std::unique_ptr<Implementation> _impl;
+    };
+
+    /**
+     * @brief Reads the records of a journal file written by the fep::EventRecorder
+     */
+    class FEP_SYSTEM_EXPORT EventJournalReader
+    {
+    public:
+        /**
+         * @brief Opens the journal file
+         *
+         * @param file_path the path of the journal file
+         * @throw runtime_error if the file can not be opened or is no event journal
+         */
+        explicit EventJournalReader(const std::string& file_path);
+        ~EventJournalReader();
+        EventJournalReader(const EventJournalReader&) = delete;
+        EventJournalReader& operator=(const EventJournalReader&) = delete;
+
+        /**
+         * @brief The resolution of all log times in the journal, as given to the fep::EventRecorder
+         */
+        MonitorTimeResolution getTimeResolution() const;
+
+        /**
+         * @brief Calls @p callback for every record selected by @p filter in the order they were written
+         *
+         * @param filter   selects the records
+         * @param callback receives the records, returns false to stop reading
+         * @return the count of records given to @p callback
+         */
+        size_t read(const EventJournalFilter& filter,
+                    const std::function<bool(const EventJournalRecord&)>& callback) const;
+
+        /**
+         * @brief Returns all records selected by @p filter in the order they were written
+         */
+        std::vector<EventJournalRecord> read(const EventJournalFilter& filter = EventJournalFilter()) const;
+
+    private:
+        struct Implementation;
+        std::unique_ptr<Implementation> _impl;
+    };
+}
@@ -20,8 +20,12 @@ You may add additional accurate notices of copyright ownership.
 #pragma once
 
 #include <string>
+#include <vector>
+#include <memory>
 #include "fep_system_types.h"
 #include "participant_proxy.h"
+#include "system_configuration.h"
+#include "typed_properties.h"
 #include "base/states/fep2_state.h"
 #include "base/logging/logging_levels.h"
 
@@ -31,13 +35,189 @@ You may add additional accurate notices of copyright ownership.
 #define FEP_SYSTEM_TRANSITION_TIME 10000
 ///The fep::discoverSystem default timeout
 #define FEP_SYSTEM_DISCOVER_TIME_MS 5000
+///The time one discovery request of fep::DiscoveryOptions collects the replies of the participants
+#define FEP_SYSTEM_DISCOVER_POLL_INTERVAL_MS 250
+///The time between two discovery rounds of the fep::System membership tracking
+#define FEP_SYSTEM_MEMBERSHIP_INTERVAL_MS 1000
 ///The fep::ParticipantProxy default timeout for every fep::ParticipantProxy call that need to connect the participant
 #define PARTICIPANT_DEFAULT_TIMEOUT 5000
+///The default capacity of the queue the events for the fep::IEventMonitor are delivered from
+#define FEP_SYSTEM_MONITOR_QUEUE_CAPACITY 4096
+///The default count of incidents per second passed on to the fep::IEventMonitor per source and incident code
+#define FEP_SYSTEM_INCIDENT_RATE_LIMIT 100
+///The default count of incidents passed on at once per source and incident code
+#define FEP_SYSTEM_INCIDENT_BURST 200
+///The count of triggers and state arrivals kept by the transition timeline
+#define FEP_SYSTEM_TRANSITION_TIMELINE_SIZE 4096
+///The count of latest latencies per participant and transition the percentiles are taken from
+#define FEP_SYSTEM_TRANSITION_LATENCY_SAMPLES 1024
+///The count of latency buckets of the fep::RPCCallMetrics, bucket i counts the latencies below 2^i microseconds
+#define FEP_SYSTEM_RPC_LATENCY_BUCKETS 25
+///The count of trace spans buffered in total, later spans are dropped until the trace is cleared
+#define FEP_SYSTEM_TRACE_BUFFER_SIZE 65536
 
 namespace fep
 {
     class IEventMonitor;
 
+    /**
+     * @brief What happens to an event for the fep::IEventMonitor if the monitoring queue is full
+     * @see @ref fep::System::setMonitoringQueue
+     */
+    enum class MonitorOverflowPolicy
+    {
+        /// the oldest queued event is dropped and counted
+        drop_oldest,
+        /// the issuing thread waits until the monitor took an event from the queue,
+        /// the slowest monitor also holds back the events of the other monitors (see fep::System::setMonitoringQueue)
+        block,
+        /// the new event is dropped and counted
+        drop_newest
+    };
+
+    /**
+     * @brief Resolution of the log time given to the fep::IEventMonitor
+     * @see @ref fep::System::setMonitoringTimeResolution
+     */
+    enum class MonitorTimeResolution
+    {
+        /// microseconds of the local time (as a_util::datetime::DateTime::toTimestamp)
+        microseconds,
+        /// nanoseconds of the local time
+        nanoseconds
+    };
+
+    /**
+     * @brief Selects the logs delivered to one fep::IEventMonitor,
+     * state and name changes are delivered to every monitor
+     * @see @ref fep::System::registerMonitoring
+     */
+    struct MonitorFilter
+    {
+        /// logs up to this severity level are delivered (additionally limited by fep::System::setSeverityLevel)
+        logging::Severity severity_level = logging::SEVERITY_DEBUG;
+        /// the categories of the delivered logs, all categories if empty
+        std::vector<logging::Category> categories;
+    };
+
+    /**
+     * @brief Limits the incidents passed on to the fep::IEventMonitor per source participant and incident code
+     * @see @ref fep::System::setIncidentRateLimit
+     */
+    struct IncidentRateLimit
+    {
+        /// incidents per second, 0 passes on every incident
+        double rate = FEP_SYSTEM_INCIDENT_RATE_LIMIT;
+        /// count of incidents passed on at once before the rate applies
+        size_t burst = FEP_SYSTEM_INCIDENT_BURST;
+        /// (ms) time after the first incident over the limit the coalesced incidents are summarized
+        timestamp_t summary_interval_ms = 1000;
+    };
+
+    /**
+     * @brief How the events are collected for the batch callbacks of one fep::IEventMonitor
+     * @see @ref fep::IEventMonitor::onLogBatch
+     */
+    struct MonitorBatchOptions
+    {
+        /// (ms) time to wait for more events after the first event of a batch, 0 delivers the queued events right away
+        timestamp_t window_ms = 0;
+        /// maximum count of events per batch
+        size_t max_batch_size = 1024;
+    };
+
+    /**
+     * @brief One trigger or observed state arrival of a participant
+     * @see @ref fep::System::getTransitionTimeline
+     */
+    struct TransitionEvent
+    {
+        /// the participant
+        std::string participant_name;
+        /// the target state of the trigger, the arrived state
+        rpc::IRPCStateMachine::State state;
+        /// true for a trigger, false for an arrival
+        bool is_trigger;
+        /// (us) local time of the trigger or arrival
+        timestamp_t time;
+    };
+
+    /**
+     * @brief The latencies from the trigger to the arrival in the target state of one participant and transition
+     * @see @ref fep::System::getTransitionLatencies
+     */
+    struct TransitionLatency
+    {
+        /// the participant
+        std::string participant_name;
+        /// the transition, one of "initialize", "start", "stop" and "shutdown"
+        std::string transition;
+        /// the target state of the transition
+        rpc::IRPCStateMachine::State target_state;
+        /// count of measured transitions
+        size_t count;
+        /// (us) the shortest latency
+        timestamp_t min;
+        /// (us) the median latency
+        timestamp_t p50;
+        /// (us) the 95th percentile of the latencies
+        timestamp_t p95;
+        /// (us) the 99th percentile of the latencies
+        timestamp_t p99;
+        /// (us) the longest latency
+        timestamp_t max;
+    };
+
+    /**
+     * @brief The calls of one method of one RPC component of one participant
+     * @see @ref fep::getRPCMetrics
+     */
+    struct RPCCallMetrics
+    {
+        /// the called participant, "*" for automation interface calls addressing several participants
+        std::string participant_name;
+        /// the RPC component ("participant_info", "state_machine", "data_registry", "configuration")
+        /// or "automation_interface"
+        std::string component;
+        /// the called method
+        std::string method;
+        /// count of calls
+        uint64_t call_count = 0;
+        /// count of calls which failed, threw or were denied
+        uint64_t error_count = 0;
+        /// bytes of the texts sent and received (names, paths, values, lists), without the protocol overhead
+        uint64_t payload_bytes = 0;
+        /// (us) the summed up latency of all calls
+        timestamp_t total_time = 0;
+        /// (us) the longest latency
+        timestamp_t max_time = 0;
+        /// (us) upper bound of the median latency
+        timestamp_t p50 = 0;
+        /// (us) upper bound of the 95th percentile of the latencies
+        timestamp_t p95 = 0;
+        /// (us) upper bound of the 99th percentile of the latencies
+        timestamp_t p99 = 0;
+        /// count of calls per latency bucket, bucket i counts the latencies below 2^i us,
+        /// the last bucket all longer ones (@ref FEP_SYSTEM_RPC_LATENCY_BUCKETS buckets)
+        std::vector<uint64_t> latency_histogram;
+    };
+
+    /**
+     * @brief How the participants of a fep::System are tracked in the background
+     * @see @ref fep::System::startMembershipTracking
+     */
+    struct MembershipTrackingOptions
+    {
+        /// (ms) time between two discovery rounds
+        timestamp_t interval_ms = FEP_SYSTEM_MEMBERSHIP_INTERVAL_MS;
+        /// (ms) time one discovery round collects the replies of the participants
+        timestamp_t discover_time_ms = FEP_SYSTEM_DISCOVER_POLL_INTERVAL_MS;
+        /// count of consecutive discovery rounds a participant did not reply to before it is removed
+        size_t missed_rounds = 3;
+        /// only add participants reporting the name of the system (see fep::DiscoveryOptions::filter_by_system_name)
+        bool filter_by_system_name = false;
+    };
+
     /**
      * @brief FEP System class is a collection of fep::ParticipantProxy.
      * 
@@ -230,6 +410,8 @@ namespace fep
         *
         * @note master_clock_name, master_time_stepsize, master_time_factor and slave_sync_cycle_time will only
         *       be set if the master_element_id is a non empty string.
+        * @note The timing properties are collected first and then written participant by participant in parallel.
+        *       If a property can not be set, the other participants may already be configured.
         *   
         */
         void configureTiming(const std::string& master_clock_name, const std::string& slave_clock_name, 
@@ -248,6 +430,94 @@ namespace fep
         void configureTiming3AFAP(const std::string& master_element_id, const std::string& master_time_stepsize) const;
 
 
+        /**
+        * Applies the desired configuration to the participants of the system.
+        * The current values are read from all participants in parallel and compared with @p desired,
+        * only the properties which differ will be set.
+        *
+        * @param[in] desired the desired property values by participant name
+        * @return std::vector<PropertyChange> the properties which were changed
+        *
+        * @throws std::runtime_error if a participant is not part of the system or one of the properties can not be set
+        */
+        std::vector<PropertyChange> applyConfiguration(const SystemConfiguration& desired) const;
+
+        /**
+        * Loads a system configuration file (JSON) and applies it to the participants of the system.
+        * The file is read and validated completely before anything is set:
+        * @code
+        * {
+        *     "timing": { "mode": "fep3_discrete_steps", "master": "Master", "master_time_stepsize": "100", "master_time_factor": "1.0" },
+        *     "properties": { "Node/Value": { "type": "double", "value": "1.0" } },
+        *     "participants": {
+        *         "Master": { "init_priority": 1, "start_priority": 2, "properties": { "Node/Values": [ 1.0, 2.5 ] } }
+        *     }
+        * }
+        * @endcode
+        * - "timing" selects one of the configureTiming functions: "mode" is one of "custom", "fep2_system_time",
+        *   "fep2_no_master", "fep2_afap", "fep3_no_master", "fep3_clock_sync_only_interpolation",
+        *   "fep3_clock_sync_only_discrete", "fep3_discrete_steps" or "fep3_afap", the parameters are
+        *   "master", "master_time_stepsize", "master_time_factor", "slave_sync_cycle_time" and
+        *   for "custom" "master_clock", "slave_clock" and "scheduler".
+        * - "properties" are set to every participant of the system, "participants" properties are set
+        *   to the named participant only and take precedence.
+        * - Property values are JSON booleans, integers, numbers, strings or arrays of them (the type is deduced)
+        *   or objects with "type" and "value".
+        *
+        * The timing is configured first, then the properties are applied as with @ref applyConfiguration,
+        * both participant by participant in parallel.
+        *
+        * @param[in] file_path path of the configuration file
+        * @return std::vector<PropertyChange> the properties which were changed (without the timing properties)
+        *
+        * @throws std::runtime_error if the file can not be read, is not valid, addresses participants which are not
+        *                            part of the system or one of the properties can not be set
+        */
+        std::vector<PropertyChange> loadConfiguration(const std::string& file_path);
+
+        /**
+        * Reads the complete property trees of all participants of the system in parallel.
+        *
+        * @return SystemConfiguration the values of all properties by participant name and full property path
+        *
+        * @throws std::runtime_error if the property tree of a participant can not be read
+        */
+        SystemConfiguration snapshotConfiguration() const;
+
+        /**
+        * Reads the complete property trees of all participants of the system in parallel
+        * and writes them to a snapshot file.
+        * The snapshot is a compact indexed binary file, it can be restored by @ref restoreConfiguration.
+        *
+        * @param[in] file_path path of the snapshot file, an existing file will be replaced
+        *
+        * @throws std::runtime_error if the property tree of a participant can not be read or the file can not be written
+        */
+        void snapshotConfiguration(const std::string& file_path) const;
+
+        /**
+        * Restores a snapshot taken by @ref snapshotConfiguration.
+        * Only the properties which differ from the snapshot are set (see @ref applyConfiguration).
+        *
+        * @param[in] snapshot the snapshot to restore
+        * @return std::vector<PropertyChange> the properties which were changed
+        *
+        * @throws std::runtime_error if a participant is not part of the system or one of the properties can not be set
+        */
+        std::vector<PropertyChange> restoreConfiguration(const SystemConfiguration& snapshot) const;
+
+        /**
+        * Restores a snapshot file written by @ref snapshotConfiguration.
+        * Only the properties which differ from the snapshot are set (see @ref applyConfiguration).
+        *
+        * @param[in] file_path path of the snapshot file
+        * @return std::vector<PropertyChange> the properties which were changed
+        *
+        * @throws std::runtime_error if the file can not be read, a participant is not part of the system
+        *                            or one of the properties can not be set
+        */
+        std::vector<PropertyChange> restoreConfiguration(const std::string& file_path) const;
+
 
         /**
         * @c getSystemState determines the aggregated state of all participants in a system.
@@ -278,14 +548,42 @@ namespace fep
         /**
         * Register monitoring listener for state and name changed notifications of the whole system
         *
+        * Several listeners may be registered, every listener is called from its own delivery thread.
+        *
         * @param [in] event_listener The listener
-        * @retval true/false        Everything went fine/Something went wrong.
+        * @throw runtime_error if the listener is already registered
         * On Failure a Incident will be send with a detailed description
         */
         void registerMonitoring(IEventMonitor& event_listener);
 
         /**
-         * Unregister monitoring listener for state and name changed and logging notifications
+        * Register monitoring listener for state and name changed notifications of the whole system
+        * and the logs selected by @p filter
+        *
+        * @param [in] event_listener The listener
+        * @param [in] filter         Selects the logs delivered to the listener
+        * @throw runtime_error if the listener is already registered
+        */
+        void registerMonitoring(IEventMonitor& event_listener, const MonitorFilter& filter);
+
+        /**
+        * Register monitoring listener for state and name changed notifications of the whole system
+        * and the logs selected by @p filter, the events are collected as given by @p batching
+        *
+        * @param [in] event_listener The listener
+        * @param [in] filter         Selects the logs delivered to the listener
+        * @param [in] batching       How the events are collected for IEventMonitor::onLogBatch
+        *                            and IEventMonitor::onStateChangedBatch
+        * @throw runtime_error if the listener is already registered
+        */
+        void registerMonitoring(IEventMonitor& event_listener,
+                                const MonitorFilter& filter,
+                                const MonitorBatchOptions& batching);
+
+        /**
+         * Unregister monitoring listener for state and name changed and logging notifications.
+         * The events queued before are delivered before this function returns,
+         * so it must not be called from within the listener.
          *
          * @param [in] event_listener The listener
          */
@@ -298,6 +596,113 @@ namespace fep
          */
         void setSeverityLevel(logging::Severity severity_level);
 
+        /**
+         * @brief Set the capacity and overflow policy of the monitoring queue.
+         *
+         * Every registered fep::IEventMonitor is called from its own delivery thread,
+         * all events (state and name changes, incidents and logs) are queued in the order they occur,
+         * so a slow monitor does not stall the threads issuing the events.
+         * Dropped events are reported to the monitor by a warning log before the next event.
+         * Events issued from within the monitor are never blocked, they drop the oldest event if the queue is full.
+         * With @ref MonitorOverflowPolicy::block the events are routed to the monitors in order by one thread,
+         * which waits while the queue of any monitor is full: one slow monitor holds back the delivery to all
+         * others and, once the common queue of the system is full as well, the threads issuing events.
+         * Default is @ref FEP_SYSTEM_MONITOR_QUEUE_CAPACITY and @ref MonitorOverflowPolicy::drop_oldest.
+         *
+         * @param capacity maximum count of queued events per monitor (at least 1)
+         * @param policy what happens to an event if the queue is full
+         */
+        void setMonitoringQueue(size_t capacity, MonitorOverflowPolicy policy);
+
+        /**
+         * @brief Set the resolution of the log time given to the fep::IEventMonitor.
+         *
+         * The log time is taken from a monotonic clock with an offset to the local wall clock,
+         * the offset is refreshed every second.
+         * Default is @ref MonitorTimeResolution::microseconds.
+         *
+         * @param resolution the resolution of the log time
+         */
+        void setMonitoringTimeResolution(MonitorTimeResolution resolution);
+
+        /**
+         * @brief Set the rate limit of the incidents passed on to the fep::IEventMonitor.
+         *
+         * Each pair of source participant and incident code has its own token bucket.
+         * The incidents over the limit are not formatted and not queued, they are counted
+         * and reported by one log "<N> occurrences in <T> ms of incident <code> ..." of their most severe level
+         * within @ref IncidentRateLimit::summary_interval_ms after the first of them plus one tick (10 ms)
+         * of the monitor routing, even if no further incident is received, and before @ref unregisterMonitoring returns.
+         * Default is @ref FEP_SYSTEM_INCIDENT_RATE_LIMIT and @ref FEP_SYSTEM_INCIDENT_BURST.
+         *
+         * @param limit the rate limit, a rate of 0 disables the limit
+         */
+        void setIncidentRateLimit(const IncidentRateLimit& limit);
+
+        /**
+         * @brief Returns the latest triggers and state arrivals of the participants, oldest first.
+         *
+         * Every trigger of @ref start, @ref stop and @ref shutdown is timestamped per participant.
+         * The arrivals are observed while the system waits for the target state
+         * and by the state change notifications while a fep::IEventMonitor is registered.
+         * The timeline keeps the latest @ref FEP_SYSTEM_TRANSITION_TIMELINE_SIZE events.
+         *
+         * @return the events
+         */
+        std::vector<TransitionEvent> getTransitionTimeline() const;
+
+        /**
+         * @brief Returns the latency histograms per participant and transition over all transitions so far.
+         *
+         * The percentiles are taken from the latest @ref FEP_SYSTEM_TRANSITION_LATENCY_SAMPLES latencies,
+         * count, min and max from all.
+         *
+         * @return the latencies, sorted by participant and transition
+         */
+        std::vector<TransitionLatency> getTransitionLatencies() const;
+
+        /**
+         * @brief Writes the latency histograms of @ref getTransitionLatencies to a CSV file
+         * with the columns participant, transition, count, min_us, p50_us, p95_us, p99_us and max_us.
+         *
+         * @param file_path the file to write, an existing file is overwritten
+         * @throw runtime_error if the file can not be written
+         */
+        void dumpTransitionLatencies(const std::string& file_path) const;
+
+        /**
+         * @brief Clears the timeline and the latency histograms
+         */
+        void clearTransitionLatencies();
+
+        /**
+         * @brief Starts tracking the participants of the system in a background thread.
+         *
+         * Participants appearing in the periodic discovery rounds are added,
+         * participants which did not reply to @ref MembershipTrackingOptions::missed_rounds rounds
+         * or which shut down are removed and renamed participants are replaced by their new name.
+         * Standalone participants are not added (like @ref fep::discoverSystem).
+         * The proxies of the added participants are connected and their cached values are read
+         * before they are added, a restarted participant's cached values are read again.
+         * The changes are notified by @ref IEventMonitor::onParticipantAdded and @ref IEventMonitor::onParticipantRemoved.
+         * A tracking started before is stopped first.
+         *
+         * @param options the interval of the discovery rounds and when participants are added and removed
+         * @throw runtime_error if the state changes of the participants can not be received
+         */
+        void startMembershipTracking(const MembershipTrackingOptions& options = MembershipTrackingOptions());
+
+        /**
+         * @brief Stops tracking the participants, the current participants are kept.
+         * Returns after the running discovery round finished.
+         */
+        void stopMembershipTracking();
+
+        /**
+         * @brief Checks whether the participants are tracked (see @ref startMembershipTracking)
+         */
+        bool isMembershipTracked() const;
+
         /// @cond no_doc    
         private:
             struct Implementation;
@@ -305,6 +710,34 @@ namespace fep
         /// @endcond no_doc    
     };
 
+    /// One log delivered by @ref fep::IEventMonitor::onLogBatch
+    struct MonitorLogRecord
+    {
+        /// time of the log
+        timestamp_t log_time = 0;
+        /// simulation time of the issuing participant, -1 if not known (e.g. for system logs)
+        timestamp_t simulation_time = -1;
+        /// category of the log
+        logging::Category category = logging::CATEGORY_SYSTEM;
+        /// severity level of the log
+        logging::Severity severity_level = logging::SEVERITY_INFO;
+        /// participant name (is empty on system category)
+        std::string participant_name;
+        /// usually the system, participant, component or element name
+        std::string logger_name;
+        /// detailed message
+        std::string message;
+    };
+
+    /// One state change delivered by @ref fep::IEventMonitor::onStateChangedBatch
+    struct MonitorStateRecord
+    {
+        /// The name of the issuing FEP Participant
+        std::string participant_name;
+        /// The new state of the issuing FEP Participant
+        rpc::IRPCStateMachine::State state;
+    };
+
     /// Virtual class to implement FEP System Event Monitor, used with 
     /// @ref fep::System::registerMonitoring 
     class IEventMonitor
@@ -347,7 +780,119 @@ namespace fep
                             const std::string& participant_name,
                             const std::string& logger_name, //depends on the Category ... 
                             const std::string& message) = 0;
+
+        /**
+         * @brief Callback on log with the simulation time of the incident.
+         *
+         * The default implementation calls @ref onLog without the simulation time.
+         *
+         * @param log_time time of the log
+         * @param simulation_time simulation time of the issuing participant, -1 if not known (e.g. for system logs)
+         * @param category category of the log
+         * @param severity_level severity level of the log
+         * @param participant_name participant name (is empty on system category )
+         * @param logger_name (usually the system, participant, component or element name)
+         * @param message detailed message
+         */
+        virtual void onLogWithSimulationTime(timestamp_t log_time,
+                                             timestamp_t simulation_time,
+                                             logging::Category category,
+                                             logging::Severity severity_level,
+                                             const std::string& participant_name,
+                                             const std::string& logger_name,
+                                             const std::string& message)
+        {
+            (void)simulation_time;
+            onLog(log_time, category, severity_level, participant_name, logger_name, message);
+        }
+
+        /**
+         * @brief Callback with consecutive logs, collected as given by fep::MonitorBatchOptions.
+         *
+         * The records are shared with the other monitors and may be kept.
+         * The default implementation calls @ref onLogWithSimulationTime for every record.
+         *
+         * @param records the logs in the order they occurred
+         */
+        virtual void onLogBatch(const std::vector<std::shared_ptr<const MonitorLogRecord>>& records)
+        {
+            for (const auto& record : records)
+            {
+                onLogWithSimulationTime(record->log_time, record->simulation_time, record->category,
+                    record->severity_level, record->participant_name, record->logger_name, record->message);
+            }
+        }
+
+        /**
+         * @brief Callback with consecutive state changes, collected as given by fep::MonitorBatchOptions.
+         *
+         * The default implementation calls @ref onStateChanged for every record.
+         *
+         * @param records the state changes in the order they occurred
+         */
+        virtual void onStateChangedBatch(const std::vector<MonitorStateRecord>& records)
+        {
+            for (const auto& record : records)
+            {
+                onStateChanged(record.participant_name, record.state);
+            }
+        }
+
+        /**
+         * @brief Callback by the membership tracking if a participant was added to the system.
+         * @see @ref fep::System::startMembershipTracking
+         *
+         * The default implementation ignores the change.
+         *
+         * @param participant_name the name of the added participant
+         */
+        virtual void onParticipantAdded(const std::string& participant_name)
+        {
+            (void)participant_name;
+        }
+
+        /**
+         * @brief Callback by the membership tracking if a participant was removed from the system.
+         * @see @ref fep::System::startMembershipTracking
+         *
+         * The default implementation ignores the change.
+         *
+         * @param participant_name the name of the removed participant
+         */
+        virtual void onParticipantRemoved(const std::string& participant_name)
+        {
+            (void)participant_name;
+        }
     };
+    /**
+     * @brief When a discovery returns before its timeout
+     *
+     * The discovery repeats requests of @ref FEP_SYSTEM_DISCOVER_POLL_INTERVAL_MS
+     * and returns as soon as one of the set conditions is satisfied, at the latest after @p timeout_ms.
+     * Without conditions it waits the whole @p timeout_ms like @ref fep::discoverSystem(std::string, timestamp_t).
+     * @see @ref fep::discoverSystem
+     */
+    struct DiscoveryOptions
+    {
+        /// (ms) the longest time to discover; has to be positive
+        timestamp_t timeout_ms = FEP_SYSTEM_DISCOVER_TIME_MS;
+        /// return as soon as at least this count of participants was discovered, 0 for no expected count
+        size_t expected_count = 0;
+        /// return as soon as all these participants were discovered, empty for no expected participants
+        std::vector<std::string> expected_participants;
+        /// (ms) return as soon as no new participant appeared for this time, 0 for no quiet period
+        timestamp_t quiet_period_ms = 0;
+        /// (ms) the time one discovery request collects the replies
+        timestamp_t poll_interval_ms = FEP_SYSTEM_DISCOVER_POLL_INTERVAL_MS;
+        /**
+         * only add the participants reporting the discovered system name (see fep::rpc::IRPCParticipantInfo::getSystemName),
+         * only their participant info is requested before. Participants without a system affiliation (FEP 2)
+         * are added, unreachable participants are left out.
+         * The conditions above count the discovered participants before this filter.
+         */
+        bool filter_by_system_name = false;
+    };
+
     /**
      * discoverSystem discovers all participants which are added to the system named by @p name.
      * Standalone participants won't be part of the created system.
@@ -380,5 +925,114 @@ namespace fep
     System FEP_SYSTEM_EXPORT discoverSystemOnDDS(std::string name,
                                                  uint16_t dds_domain_id,
                                                  timestamp_t timeout_ms = FEP_SYSTEM_DISCOVER_TIME_MS);
+    /**
+     * discoverSystem discovers the participants which are added to the system named by @p name
+     * and returns as soon as the conditions of @p options are satisfied.
+     * Standalone participants won't be part of the created system.
+     *
+     * It will use the default service bus discovery provided by the fep sdk library
+     *
+     * @param[in]  name     name of the system which is discovered
+     * @param[in]  options  the expected participants, the quiet period and the timeout
+     * @return Discovered system
+     * @throw runtime_error throws if one of the discovered participants is not available
+     *                      (for filtering of standalone participants)
+     */
+    System FEP_SYSTEM_EXPORT discoverSystem(std::string name,
+                                            const DiscoveryOptions& options);
+    /**
+     * discoverSystemOnDDS discovers the participants which are added to the system named by @p name
+     * and returns as soon as the conditions of @p options are satisfied.
+     * Standalone participants won't be part of the created system.
+     *
+     * Only participants using DDS and the domain ID @p dds_domain_id will be discovered.
+     *
+     * @param[in]  name           name of the system to discover
+     * @param[in]  dds_domain_id  dds domain
+     * @param[in]  options        the expected participants, the quiet period and the timeout
+     * @return Discovered system
+     * @throw runtime_error throws if one of the discovered participants is not available
+     *                      (for filtering of standalone participants)
+     */
+    System FEP_SYSTEM_EXPORT discoverSystemOnDDS(std::string name,
+                                                 uint16_t dds_domain_id,
+                                                 const DiscoveryOptions& options);
+    /**
+     * discoverSystem discovers the participants which are added to the system named by @p name
+     * like @ref fep::discoverSystem(std::string, const DiscoveryOptions&) and returns their metadata.
+     * The metadata of all participants is read concurrently in the same pass as the standalone mode
+     * and stays cached on the participant proxies of the system (see @ref ParticipantProxy::getMetadata),
+     * so the RPC components are not requested again when their proxies are resolved.
+     *
+     * @param[in]  name                   name of the system which is discovered
+     * @param[in]  options                the expected participants, the quiet period and the timeout
+     * @param[out] discovered_participants the metadata of the participants of the discovered system, ordered by name
+     * @return Discovered system
+     * @throw runtime_error throws if one of the discovered participants is not available
+     */
+    System FEP_SYSTEM_EXPORT discoverSystem(std::string name,
+                                            const DiscoveryOptions& options,
+                                            std::vector<DiscoveredParticipant>& discovered_participants);
+    /**
+     * discoverSystemOnDDS discovers the participants which are added to the system named by @p name
+     * like @ref fep::discoverSystemOnDDS(std::string, uint16_t, const DiscoveryOptions&) and returns their metadata
+     * (see @ref fep::discoverSystem(std::string, const DiscoveryOptions&, std::vector<DiscoveredParticipant>&)).
+     *
+     * @param[in]  name                   name of the system to discover
+     * @param[in]  dds_domain_id          dds domain
+     * @param[in]  options                the expected participants, the quiet period and the timeout
+     * @param[out] discovered_participants the metadata of the participants of the discovered system, ordered by name
+     * @return Discovered system
+     * @throw runtime_error throws if one of the discovered participants is not available
+     */
+    System FEP_SYSTEM_EXPORT discoverSystemOnDDS(std::string name,
+                                                 uint16_t dds_domain_id,
+                                                 const DiscoveryOptions& options,
+                                                 std::vector<DiscoveredParticipant>& discovered_participants);
+
+    /**
+     * Enables or disables the metrics of the RPC calls to the participants (see @ref fep::RPCCallMetrics).
+     * The metrics cover the calls of all systems of this process, they are disabled by default.
+     * A call costs one check of the flag while they are disabled.
+     *
+     * @param[in]  enabled  true to count the calls from now on
+     */
+    void FEP_SYSTEM_EXPORT setRPCMetricsEnabled(bool enabled);
+
+    /**
+     * Returns the metrics of the RPC calls counted so far per participant, component and method.
+     *
+     * @return the metrics, sorted by participant, component and method
+     */
+    std::vector<RPCCallMetrics> FEP_SYSTEM_EXPORT getRPCMetrics();
+
+    /**
+     * Clears the metrics of the RPC calls counted so far.
+     */
+    void FEP_SYSTEM_EXPORT resetRPCMetrics();
+
+    /**
+     * Enables or disables the tracing of the system control operations of all systems of this process.
+     * Spans are recorded around start, stop and shutdown, each group of triggered participants,
+     * each round of awaiting the participant states, each resolution of a participant's RPC component proxy
+     * and each property write. Tracing is disabled by default, a span costs one check of the flag then.
+     *
+     * @param[in]  enabled  true to record the spans from now on
+     */
+    void FEP_SYSTEM_EXPORT setTracingEnabled(bool enabled);
+
+    /**
+     * Writes the spans recorded so far as Chrome trace event JSON,
+     * viewable in chrome://tracing or Perfetto (https://ui.perfetto.dev).
+     *
+     * @param[in]  file_path  the path of the JSON file, an existing file is overwritten
+     * @throw runtime_error if the file can not be written
+     */
+    void FEP_SYSTEM_EXPORT writeTrace(const std::string& file_path);
+
+    /**
+     * Discards the spans recorded so far.
+     */
+    void FEP_SYSTEM_EXPORT clearTrace();
 
 }
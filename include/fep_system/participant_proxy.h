@@ -27,9 +27,31 @@ You may add additional accurate notices of copyright ownership.
 #include "system_logger_intf.h"
 
 #include <string>
+#include <vector>
+#include <map>
 
 namespace fep
 {
+    /**
+     * @brief The metadata of a participant read by the discovery in one pass
+     * @see @ref fep::discoverSystem(std::string, const DiscoveryOptions&, std::vector<DiscoveredParticipant>&)
+     * @see @ref fep::ParticipantProxy::getMetadata
+     */
+    struct DiscoveredParticipant
+    {
+        /// the name of the participant
+        std::string name;
+        /// the FEP version of the participant
+        double fep_version = 0.0;
+        /// the state the participant replied to the discovery, FS_UNKNOWN if not discovered
+        rpc::IRPCStateMachine::State state = FS_UNKNOWN;
+        /// the system name the participant reports (see fep::rpc::IRPCParticipantInfo::getSystemName)
+        std::string system_name;
+        /// the RPC components of the participant and the interface ids each of them supports
+        std::map<std::string, std::vector<std::string>> rpc_components;
+        /// true if the participant is a standalone participant
+        bool standalone = false;
+    };
 
 
     /**
@@ -165,6 +187,34 @@ namespace fep
          */
         std::string getAdditionalInfo(const std::string& key, const std::string& value_default) const;
 
+        /**
+         * @brief Checks whether the participant is a standalone participant.
+         * The value is read once from the participant's configuration and cached on the proxy
+         * (and all its copies) until @ref invalidateCache is called.
+         *
+         * @return true the participant is a standalone participant
+         * \throw runtime_error the participant is not reachable
+         */
+        bool isStandalone() const;
+
+        /**
+         * @brief Discards the values cached from the participant, i.e. after the participant restarted.
+         * The values are read again when they are requested the next time.
+         * The fep::System calls this when it observes or triggers a restart or shutdown of the participant.
+         */
+        void invalidateCache() const;
+
+        /**
+         * @brief Reads the FEP version, the reported system name, the RPC components and the standalone mode
+         * of the participant. The values are cached on the proxy like @ref isStandalone,
+         * the cached version and components are also used to resolve the RPC component proxies.
+         * The state is not read (FS_UNKNOWN), the discovery fills in the state replied to it.
+         *
+         * @return the metadata of the participant
+         * \throw runtime_error the participant is not reachable
+         */
+        DiscoveredParticipant getMetadata() const;
+
         /**
          * @brief the getRPComponent internal interface will try to connect to the Participant RPC Server (@ref fep_rpc_server)
          * 
@@ -26,6 +26,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <stdexcept>
 #include "configuration_rpc_intf_def.h"
 #include "../../base/properties/properties_intf.h"
 
@@ -34,6 +35,31 @@ namespace fep
 {
 namespace rpc
 {
+    /**
+     * @brief Listener for property changes, see @ref IRPCConfiguration::registerPropertyListener
+     */
+    class IPropertyChangeListener
+    {
+        protected:
+            /**
+             * @brief Destroy the IPropertyChangeListener object
+             *
+             */
+            virtual ~IPropertyChangeListener() = default;
+
+        public:
+            /**
+             * @brief called when the value of a watched property has changed
+             *
+             * @param participant_name name of the participant the property belongs to
+             * @param property_path full path of the property ('/' separated, without leading '/')
+             * @param value the new value
+             */
+            virtual void onPropertyChanged(const std::string& participant_name,
+                                           const std::string& property_path,
+                                           const std::string& value) = 0;
+    };
+
     /**
      * @brief definition of the external service interface for the participants configuration
      * You will be able to set and get properties.
@@ -69,6 +95,44 @@ namespace rpc
              * @retval empty_shared_ptr property does not exists
              */
             virtual std::shared_ptr<const IProperties> getProperties(const std::string& property_path) const = 0;
+
+            /**
+             * @brief registers a listener which is called when the value of the property changes.
+             * The value at registration time is the reference, changes are detected by one shared poller
+             * per participant which reads every watched property once per cycle, no matter how many
+             * listeners are registered.
+             * The registration is kept for the participant (not for this proxy instance)
+             * until it is unregistered or the participant is removed from the system.
+             * Listeners may be registered from within a listener.
+             * The default implementation does not support listeners.
+             *
+             * @param property_path full path of the property ('.' or '/' separated)
+             * @param listener the listener, it is called from the poller thread
+             *
+             * @throw std::runtime_error if the participant is not part of a system anymore
+             *                           or the implementation does not support listeners
+             */
+            virtual void registerPropertyListener(const std::string& property_path,
+                                                  IPropertyChangeListener& listener)
+            {
+                (void)listener;
+                throw std::runtime_error{ "property listeners are not supported, can not watch " + property_path };
+            }
+            /**
+             * @brief unregisters a listener registered with @ref registerPropertyListener.
+             * The listener is not called anymore when this function returns,
+             * so it must not be called from within a listener.
+             * The default implementation does nothing, since it never registers listeners.
+             *
+             * @param property_path full path of the property as given at registration
+             * @param listener the listener
+             */
+            virtual void unregisterPropertyListener(const std::string& property_path,
+                                                    IPropertyChangeListener& listener)
+            {
+                (void)property_path;
+                (void)listener;
+            }
     };
 }
 }
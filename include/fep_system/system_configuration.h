@@ -0,0 +1,68 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+
+#pragma once
+
+#include <string>
+#include <map>
+#include <vector>
+
+namespace fep
+{
+    /**
+     * @brief Value and type of one property as string representation
+     * (see fep::DefaultPropertyTypeConversion and fep::PropertyType)
+     */
+    struct PropertyValue
+    {
+        ///value of the property
+        std::string value;
+        ///type name of the property
+        std::string type;
+    };
+
+    /**
+     * @brief The desired properties of one participant.
+     * The key is the full property path (i.e. "Clock/MainClock"), '.' will be treated as '/'.
+     */
+    using ParticipantConfiguration = std::map<std::string, PropertyValue>;
+
+    /**
+     * @brief The desired properties of a system.
+     * The key is the participant name.
+     */
+    using SystemConfiguration = std::map<std::string, ParticipantConfiguration>;
+
+    /**
+     * @brief One property which was changed by fep::System::applyConfiguration
+     */
+    struct PropertyChange
+    {
+        ///name of the participant the property belongs to
+        std::string participant;
+        ///full property path (with '/')
+        std::string path;
+        ///value before the change, empty if the property did not exist
+        std::string old_value;
+        ///value which was set
+        std::string new_value;
+        ///type name of the property which was set
+        std::string type;
+    };
+}
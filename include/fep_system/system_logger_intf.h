@@ -33,5 +33,31 @@ namespace fep
                              const std::string& participant_name,
                              const std::string& logger_name, //depends on the Category ... 
                              const std::string& message) const = 0;
+
+            /**
+             * @brief returns whether a log of @p level would be delivered at all,
+             * so callers may skip creating the message
+             */
+            virtual bool isLogEnabled(logging::Severity /*level*/) const
+            {
+                return true;
+            }
+
+            /**
+             * @brief logs the message returned by @p create_message,
+             * which is only called if a log of @p level is enabled (see isLogEnabled)
+             */
+            template<typename CreateMessage>
+            void logLazy(logging::Category cat,
+                         logging::Severity level,
+                         const std::string& participant_name,
+                         const std::string& logger_name,
+                         CreateMessage&& create_message) const
+            {
+                if (isLogEnabled(level))
+                {
+                    log(cat, level, participant_name, logger_name, create_message());
+                }
+            }
     };
 }
@@ -0,0 +1,121 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "fep_system_types.h"
+#include "base/properties/properties_intf.h"
+
+namespace fep
+{
+    /**
+     * @brief Sets a property of a properties node retrieved by fep::rpc::IRPCConfiguration::getProperties
+     * without converting the value to a string representation first.
+     *
+     * If the node is not provided by the fep::System configuration proxies the value will be set
+     * by the string based IProperties::setProperty.
+     *
+     * @param properties the properties node
+     * @param name name of the property (relative to the node)
+     * @param value the value to set, the type name is determined by the type of @p value
+     * @return true the property was set
+     * @return false the property was not set, see IEventMonitor::onLog for details
+     */
+    FEP_SYSTEM_EXPORT bool setPropertyValue(IProperties& properties, const std::string& name, bool value);
+    /// @copydoc setPropertyValue(IProperties&, const std::string&, bool)
+    FEP_SYSTEM_EXPORT bool setPropertyValue(IProperties& properties, const std::string& name, int32_t value);
+    /// @copydoc setPropertyValue(IProperties&, const std::string&, bool)
+    FEP_SYSTEM_EXPORT bool setPropertyValue(IProperties& properties, const std::string& name, double value);
+    /// @copydoc setPropertyValue(IProperties&, const std::string&, bool)
+    FEP_SYSTEM_EXPORT bool setPropertyValue(IProperties& properties, const std::string& name, const std::string& value);
+    /// @copydoc setPropertyValue(IProperties&, const std::string&, bool)
+    FEP_SYSTEM_EXPORT bool setPropertyValue(IProperties& properties, const std::string& name, const std::vector<bool>& value);
+    /// @copydoc setPropertyValue(IProperties&, const std::string&, bool)
+    FEP_SYSTEM_EXPORT bool setPropertyValue(IProperties& properties, const std::string& name, const std::vector<int32_t>& value);
+    /// @copydoc setPropertyValue(IProperties&, const std::string&, bool)
+    FEP_SYSTEM_EXPORT bool setPropertyValue(IProperties& properties, const std::string& name, const std::vector<double>& value);
+    /// @copydoc setPropertyValue(IProperties&, const std::string&, bool)
+    FEP_SYSTEM_EXPORT bool setPropertyValue(IProperties& properties, const std::string& name, const std::vector<std::string>& value);
+    /// @copydoc setPropertyValue(IProperties&, const std::string&, bool)
+    inline bool setPropertyValue(IProperties& properties, const std::string& name, const char* value)
+    {
+        return setPropertyValue(properties, name, std::string(value));
+    }
+
+    /**
+     * @brief Gets a property of a properties node retrieved by fep::rpc::IRPCConfiguration::getProperties
+     * without parsing a string representation.
+     *
+     * @param properties the properties node
+     * @param name name of the property (relative to the node)
+     * @param value will contain the value
+     * @return true the property exists and has the type of @p value
+     * @return false the property does not exist or has a different type, @p value is unchanged
+     */
+    FEP_SYSTEM_EXPORT bool getPropertyValue(const IProperties& properties, const std::string& name, bool& value);
+    /// @copydoc getPropertyValue(const IProperties&, const std::string&, bool&)
+    FEP_SYSTEM_EXPORT bool getPropertyValue(const IProperties& properties, const std::string& name, int32_t& value);
+    /// @copydoc getPropertyValue(const IProperties&, const std::string&, bool&)
+    FEP_SYSTEM_EXPORT bool getPropertyValue(const IProperties& properties, const std::string& name, double& value);
+    /// @copydoc getPropertyValue(const IProperties&, const std::string&, bool&)
+    FEP_SYSTEM_EXPORT bool getPropertyValue(const IProperties& properties, const std::string& name, std::string& value);
+    /// @copydoc getPropertyValue(const IProperties&, const std::string&, bool&)
+    FEP_SYSTEM_EXPORT bool getPropertyValue(const IProperties& properties, const std::string& name, std::vector<bool>& value);
+    /// @copydoc getPropertyValue(const IProperties&, const std::string&, bool&)
+    FEP_SYSTEM_EXPORT bool getPropertyValue(const IProperties& properties, const std::string& name, std::vector<int32_t>& value);
+    /// @copydoc getPropertyValue(const IProperties&, const std::string&, bool&)
+    FEP_SYSTEM_EXPORT bool getPropertyValue(const IProperties& properties, const std::string& name, std::vector<double>& value);
+    /// @copydoc getPropertyValue(const IProperties&, const std::string&, bool&)
+    FEP_SYSTEM_EXPORT bool getPropertyValue(const IProperties& properties, const std::string& name, std::vector<std::string>& value);
+
+    /**
+     * @brief Gets a property value of type @p T
+     *
+     * @tparam T one of bool, int32_t, double, std::string or the std::vector of these
+     * @param properties the properties node
+     * @param name name of the property (relative to the node)
+     * @param default_value the value to return if the property does not exist or has a different type
+     * @return T the value
+     */
+    template<typename T>
+    T getPropertyValue(const IProperties& properties, const std::string& name, const T& default_value = T())
+    {
+        T value = default_value;
+        if (getPropertyValue(properties, name, value))
+        {
+            return value;
+        }
+        return default_value;
+    }
+
+    /**
+     * @brief Drops the values a properties node retrieved by fep::rpc::IRPCConfiguration::getProperties has cached.
+     *
+     * Properties nodes of FEP 2 participants retrieve the whole subtree once and serve
+     * all reads (value, type and names) from it. Values set by the node itself are refreshed automatically,
+     * changes done by the participant or other systems are visible after calling this function.
+     * Other properties nodes are not affected.
+     *
+     * @param properties the properties node
+     */
+    FEP_SYSTEM_EXPORT void refreshProperties(const IProperties& properties);
+}
@@ -0,0 +1,180 @@
+/**
+ * Prints the records of an event journal written by the fep::EventRecorder
+ *
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+
+#include <stdlib.h>
+#include <iostream>
+#include <string>
+#include <stdexcept>
+
+#include <fep_system/event_recorder.h>
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "usage: fep_event_journal <journal file> [options]" << std::endl;
+        std::cout << "  --participant <name>  only events of this participant" << std::endl;
+        std::cout << "  --begin <time>        only events at or after this log time (in the unit of the journal)" << std::endl;
+        std::cout << "  --end <time>          only events at or before this log time (in the unit of the journal)" << std::endl;
+        std::cout << "  --severity <level>    only logs of this level or more severe:" << std::endl;
+        std::cout << "                        fatal, error, warning, info, debug" << std::endl;
+        std::cout << "  --logs-only           no state and name changes" << std::endl;
+    }
+
+    bool parseSeverity(const std::string& text, fep::logging::Severity& severity)
+    {
+        if (text == "fatal")
+        {
+            severity = fep::logging::SEVERITY_FATAL;
+        }
+        else if (text == "error")
+        {
+            severity = fep::logging::SEVERITY_ERROR;
+        }
+        else if (text == "warning")
+        {
+            severity = fep::logging::SEVERITY_WARNING;
+        }
+        else if (text == "info")
+        {
+            severity = fep::logging::SEVERITY_INFO;
+        }
+        else if (text == "debug")
+        {
+            severity = fep::logging::SEVERITY_DEBUG;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    const char* getSeverityName(fep::logging::Severity severity)
+    {
+        switch (severity)
+        {
+        case fep::logging::SEVERITY_FATAL:
+            return "fatal";
+        case fep::logging::SEVERITY_ERROR:
+            return "error";
+        case fep::logging::SEVERITY_WARNING:
+            return "warning";
+        case fep::logging::SEVERITY_INFO:
+            return "info";
+        case fep::logging::SEVERITY_DEBUG:
+            return "debug";
+        default:
+            return "off";
+        }
+    }
+
+    void printRecord(const fep::EventJournalRecord& record)
+    {
+        std::cout << record.log_time << "\t";
+        switch (record.type)
+        {
+        case fep::EventJournalRecord::Type::state_changed:
+            std::cout << "state\t" << record.participant_name << "\t" << record.state;
+            break;
+        case fep::EventJournalRecord::Type::name_changed:
+            std::cout << "rename\t" << record.participant_name << "\t" << record.message;
+            break;
+        default:
+            std::cout << getSeverityName(record.severity_level) << "\t" << record.participant_name
+                << "\t" << record.logger_name << "\t";
+            if (record.simulation_time >= 0)
+            {
+                std::cout << "[" << record.simulation_time << "] ";
+            }
+            std::cout << record.message;
+            break;
+        }
+        std::cout << "\n";
+    }
+}
+
+/*
+ * Main function of the journal reader
+ *
+ * Prints the unit of the log times, then one line per selected record: log time, kind (or severity), participant and the details.
+ */
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        printUsage();
+        return 1;
+    }
+
+    fep::EventJournalFilter filter;
+    for (int idx = 2; idx < argc; ++idx)
+    {
+        const std::string option = argv[idx];
+        if (option == "--logs-only")
+        {
+            filter.include_state_changes = false;
+            continue;
+        }
+        if (idx + 1 >= argc)
+        {
+            printUsage();
+            return 1;
+        }
+        const std::string value = argv[++idx];
+        if (option == "--participant")
+        {
+            filter.participant_name = value;
+        }
+        else if (option == "--begin")
+        {
+            filter.begin_time = strtoll(value.c_str(), nullptr, 10);
+        }
+        else if (option == "--end")
+        {
+            filter.end_time = strtoll(value.c_str(), nullptr, 10);
+        }
+        else if (option != "--severity" || !parseSeverity(value, filter.severity_level))
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    try
+    {
+        fep::EventJournalReader reader(argv[1]);
+        std::cout << "# log time in "
+            << (reader.getTimeResolution() == fep::MonitorTimeResolution::nanoseconds ? "nanoseconds" : "microseconds")
+            << "\n";
+        reader.read(filter, [](const fep::EventJournalRecord& record)
+        {
+            printRecord(record);
+            return true;
+        });
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+    std::cout.flush();
+    return 0;
+}
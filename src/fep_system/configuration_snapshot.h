@@ -0,0 +1,264 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <cstdint>
+
+#include "fep_system/participant_proxy.h"
+#include "fep_system/system_configuration.h"
+#include "typed_properties_intf.h"
+
+namespace fep
+{
+    /**
+     * @brief reads all properties of one participant.
+     * The configuration proxies read the tree at once (see IPropertyTreeReader).
+     *
+     * @param participant the participant to read from
+     * @return the properties by full property path ('/' separated, without leading '/')
+     * @throw std::runtime_error if the property tree can not be read
+     */
+    inline ParticipantConfiguration snapshotParticipantConfiguration(const ParticipantProxy& participant)
+    {
+        auto config_rpc_client = participant.getRPCComponentProxy<fep::rpc::IRPCConfiguration>();
+        auto root = config_rpc_client->getProperties("/");
+        auto tree = dynamic_cast<const IPropertyTreeReader*>(root.get());
+        if (!tree)
+        {
+            throw std::runtime_error{ "the property tree of participant " + participant.getName() + " can not be read" };
+        }
+        ParticipantConfiguration values;
+        tree->readTree(values);
+        return values;
+    }
+
+    /**
+     * @brief Binary file format of a configuration snapshot.
+     *
+     * All numbers are 32 bit unsigned little endian, all records have a fixed size,
+     * so the file can be used in place (i.e. memory mapped) without parsing:
+     * @code
+     * header      magic "FEPCSNP1", participant_count, entry_count, strings_offset, strings_size
+     * participant participant_count x { name_offset, name_size, first_entry, entry_count }, sorted by name
+     * entry       entry_count x { path_offset, path_size, type_offset, type_size, value_offset, value_size },
+     *             sorted by path within each participant
+     * strings     all strings without terminator, equal strings (e.g. the type names) are stored once
+     * @endcode
+     * The offsets of the strings are relative to strings_offset.
+     */
+    namespace configuration_snapshot
+    {
+        static const char magic[] = "FEPCSNP1";
+        static const size_t magic_size = 8;
+        static const size_t header_size = magic_size + 4 * 4;
+        static const size_t participant_record_size = 4 * 4;
+        static const size_t entry_record_size = 6 * 4;
+
+        inline void writeNumber(std::string& buffer, size_t value)
+        {
+            if (value > UINT32_MAX)
+            {
+                throw std::runtime_error{ "the configuration is too large for a snapshot" };
+            }
+            for (int byte = 0; byte < 4; ++byte)
+            {
+                buffer.push_back(static_cast<char>((value >> (byte * 8)) & 0xFF));
+            }
+        }
+
+        inline uint32_t readNumber(const std::string& buffer, size_t offset)
+        {
+            uint32_t value = 0;
+            for (size_t byte = 0; byte < 4; ++byte)
+            {
+                value |= static_cast<uint32_t>(static_cast<unsigned char>(buffer[offset + byte])) << (byte * 8);
+            }
+            return value;
+        }
+
+        /**
+         * @brief collects the strings of the snapshot, every distinct string is stored once
+         */
+        class StringTable
+        {
+        public:
+            void write(std::string& buffer, const std::string& value)
+            {
+                auto found = _offsets.find(value);
+                if (found == _offsets.end())
+                {
+                    found = _offsets.emplace(value, _strings.size()).first;
+                    _strings.append(value);
+                }
+                writeNumber(buffer, found->second);
+                writeNumber(buffer, value.size());
+            }
+
+            const std::string& getStrings() const
+            {
+                return _strings;
+            }
+
+        private:
+            std::map<std::string, size_t> _offsets;
+            std::string _strings;
+        };
+
+        /**
+         * @brief serializes the configuration to the snapshot format
+         */
+        inline std::string serialize(const SystemConfiguration& configuration)
+        {
+            size_t entry_count = 0;
+            for (const auto& participant : configuration)
+            {
+                entry_count += participant.second.size();
+            }
+            const size_t strings_offset = header_size
+                + configuration.size() * participant_record_size
+                + entry_count * entry_record_size;
+
+            StringTable strings;
+            std::string participants;
+            std::string entries;
+            size_t first_entry = 0;
+            for (const auto& participant : configuration)
+            {
+                strings.write(participants, participant.first);
+                writeNumber(participants, first_entry);
+                writeNumber(participants, participant.second.size());
+                for (const auto& property : participant.second)
+                {
+                    strings.write(entries, property.first);
+                    strings.write(entries, property.second.type);
+                    strings.write(entries, property.second.value);
+                }
+                first_entry += participant.second.size();
+            }
+
+            std::string buffer(magic, magic_size);
+            writeNumber(buffer, configuration.size());
+            writeNumber(buffer, entry_count);
+            writeNumber(buffer, strings_offset);
+            writeNumber(buffer, strings.getStrings().size());
+            buffer.append(participants);
+            buffer.append(entries);
+            buffer.append(strings.getStrings());
+            return buffer;
+        }
+
+        /**
+         * @brief deserializes a snapshot
+         *
+         * @throw std::runtime_error if @p buffer is no valid snapshot
+         */
+        inline SystemConfiguration deserialize(const std::string& buffer)
+        {
+            if (buffer.size() < header_size || buffer.compare(0, magic_size, magic) != 0)
+            {
+                throw std::runtime_error{ "no configuration snapshot" };
+            }
+            const size_t participant_count = readNumber(buffer, magic_size);
+            const size_t entry_count = readNumber(buffer, magic_size + 4);
+            const size_t strings_offset = readNumber(buffer, magic_size + 8);
+            const size_t strings_size = readNumber(buffer, magic_size + 12);
+            if (strings_offset != header_size + participant_count * participant_record_size + entry_count * entry_record_size
+                || strings_offset + strings_size != buffer.size())
+            {
+                throw std::runtime_error{ "the configuration snapshot is corrupted" };
+            }
+
+            auto readString = [&](size_t record_offset) -> std::string
+            {
+                const size_t offset = readNumber(buffer, record_offset);
+                const size_t size = readNumber(buffer, record_offset + 4);
+                if (offset + size > strings_size)
+                {
+                    throw std::runtime_error{ "the configuration snapshot is corrupted" };
+                }
+                return buffer.substr(strings_offset + offset, size);
+            };
+
+            SystemConfiguration configuration;
+            const size_t entries_offset = header_size + participant_count * participant_record_size;
+            for (size_t participant_idx = 0; participant_idx < participant_count; ++participant_idx)
+            {
+                const size_t record_offset = header_size + participant_idx * participant_record_size;
+                const size_t first_entry = readNumber(buffer, record_offset + 8);
+                const size_t participant_entry_count = readNumber(buffer, record_offset + 12);
+                if (first_entry + participant_entry_count > entry_count)
+                {
+                    throw std::runtime_error{ "the configuration snapshot is corrupted" };
+                }
+                auto& participant = configuration[readString(record_offset)];
+                for (size_t entry_idx = first_entry; entry_idx < first_entry + participant_entry_count; ++entry_idx)
+                {
+                    const size_t entry_offset = entries_offset + entry_idx * entry_record_size;
+                    auto& property = participant[readString(entry_offset)];
+                    property.type = readString(entry_offset + 8);
+                    property.value = readString(entry_offset + 16);
+                }
+            }
+            return configuration;
+        }
+
+        /**
+         * @brief writes the configuration as snapshot file
+         *
+         * @throw std::runtime_error if the file can not be written
+         */
+        inline void write(const std::string& file_path, const SystemConfiguration& configuration)
+        {
+            const auto buffer = serialize(configuration);
+            std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+            if (!file.write(buffer.data(), buffer.size()))
+            {
+                throw std::runtime_error{ "the configuration snapshot " + file_path + " can not be written" };
+            }
+        }
+
+        /**
+         * @brief reads a snapshot file
+         *
+         * @throw std::runtime_error if the file can not be read or is no valid snapshot
+         */
+        inline SystemConfiguration read(const std::string& file_path)
+        {
+            std::ifstream file(file_path, std::ios::binary);
+            if (!file)
+            {
+                throw std::runtime_error{ "the configuration snapshot " + file_path + " can not be read" };
+            }
+            const std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            try
+            {
+                return deserialize(buffer);
+            }
+            catch (const std::runtime_error& ex)
+            {
+                throw std::runtime_error{ file_path + ": " + ex.what() };
+            }
+        }
+    }
+}
@@ -0,0 +1,587 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+
+#include <fep_system/event_recorder.h>
+#include <log_clock.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+
+#ifdef WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fep
+{
+    namespace
+    {
+        const char journal_magic[8] = { 'F', 'E', 'P', 'E', 'V', 'J', 'N', 'L' };
+        const uint32_t journal_version = 1;
+
+        /// the start of the file, end is the size of the file up to the last complete record
+        struct JournalHeader
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t header_size;
+            uint64_t end;
+            uint64_t record_count;
+            /// the MonitorTimeResolution of all log times in the journal
+            uint8_t time_resolution;
+            uint8_t reserved[7];
+        };
+
+        /// every record starts 8 byte aligned with this header followed by the texts (not terminated)
+        struct RecordHeader
+        {
+            uint32_t size;
+            uint8_t type;
+            uint8_t severity;
+            uint8_t category;
+            int8_t state;
+            int64_t log_time;
+            int64_t simulation_time;
+            uint16_t participant_size;
+            uint16_t logger_size;
+            uint32_t message_size;
+        };
+
+        static_assert(sizeof(JournalHeader) == 40, "the journal header is part of the file format");
+        static_assert(sizeof(RecordHeader) == 32, "the record header is part of the file format");
+
+        uint64_t alignRecordSize(uint64_t size)
+        {
+            return (size + 7) & ~static_cast<uint64_t>(7);
+        }
+
+        /**
+         * @brief a file mapped to memory for writing, the file grows with the mapping
+         */
+        class MappedFile
+        {
+        public:
+            explicit MappedFile(const std::string& file_path)
+            {
+#ifdef WIN32
+                _file = CreateFileA(file_path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                    nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (_file == INVALID_HANDLE_VALUE)
+#else
+                _file = ::open(file_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+                if (_file < 0)
+#endif
+                {
+                    throw std::runtime_error("the event journal " + file_path + " can not be created");
+                }
+            }
+            ~MappedFile()
+            {
+                close(_size);
+            }
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            char* data() const
+            {
+                return _data;
+            }
+
+            uint64_t size() const
+            {
+                return _size;
+            }
+
+            /**
+             * @brief resizes the file to @p size and maps it
+             *
+             * @return false if the file can not be resized or mapped, the mapping is gone then
+             */
+            bool resize(uint64_t size)
+            {
+                unmap();
+#ifdef WIN32
+                _mapping = CreateFileMappingA(_file, nullptr, PAGE_READWRITE,
+                    static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+                if (!_mapping)
+                {
+                    return false;
+                }
+                _data = static_cast<char*>(MapViewOfFile(_mapping, FILE_MAP_WRITE, 0, 0, static_cast<SIZE_T>(size)));
+                if (!_data)
+                {
+                    unmap();
+                    return false;
+                }
+#else
+                if (::ftruncate(_file, static_cast<off_t>(size)) != 0)
+                {
+                    return false;
+                }
+                void* data = ::mmap(nullptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE, MAP_SHARED, _file, 0);
+                if (data == MAP_FAILED)
+                {
+                    return false;
+                }
+                _data = static_cast<char*>(data);
+#endif
+                _size = size;
+                return true;
+            }
+
+            void flush()
+            {
+                if (!_data)
+                {
+                    return;
+                }
+#ifdef WIN32
+                FlushViewOfFile(_data, 0);
+#else
+                ::msync(_data, static_cast<size_t>(_size), MS_ASYNC);
+#endif
+            }
+
+            /**
+             * @brief unmaps the file and cuts it to @p size
+             */
+            void close(uint64_t size)
+            {
+                unmap();
+#ifdef WIN32
+                if (_file != INVALID_HANDLE_VALUE)
+                {
+                    LARGE_INTEGER position;
+                    position.QuadPart = static_cast<LONGLONG>(size);
+                    if (SetFilePointerEx(_file, position, nullptr, FILE_BEGIN))
+                    {
+                        SetEndOfFile(_file);
+                    }
+                    CloseHandle(_file);
+                    _file = INVALID_HANDLE_VALUE;
+                }
+#else
+                if (_file >= 0)
+                {
+                    if (::ftruncate(_file, static_cast<off_t>(size)) != 0)
+                    {
+                        //the file keeps the unused tail, the header tells the end of the records
+                    }
+                    ::close(_file);
+                    _file = -1;
+                }
+#endif
+            }
+
+        private:
+            void unmap()
+            {
+#ifdef WIN32
+                if (_data)
+                {
+                    UnmapViewOfFile(_data);
+                }
+                if (_mapping)
+                {
+                    CloseHandle(_mapping);
+                    _mapping = nullptr;
+                }
+#else
+                if (_data)
+                {
+                    ::munmap(_data, static_cast<size_t>(_size));
+                }
+#endif
+                _data = nullptr;
+                _size = 0;
+            }
+
+#ifdef WIN32
+            HANDLE _file = INVALID_HANDLE_VALUE;
+            HANDLE _mapping = nullptr;
+#else
+            int _file = -1;
+#endif
+            char* _data = nullptr;
+            uint64_t _size = 0;
+        };
+    }
+
+    struct EventRecorder::Implementation
+    {
+        Implementation(const std::string& file_path, MonitorTimeResolution resolution, size_t chunk_size) :
+            _file(file_path), _resolution(resolution), _chunk_size(std::max<size_t>(chunk_size, 4096))
+        {
+            if (!_file.resize(_chunk_size))
+            {
+                throw std::runtime_error("the event journal " + file_path + " can not be mapped");
+            }
+            JournalHeader header;
+            memcpy(header.magic, journal_magic, sizeof(journal_magic));
+            header.version = journal_version;
+            header.header_size = sizeof(JournalHeader);
+            header.end = sizeof(JournalHeader);
+            header.record_count = 0;
+            header.time_resolution = static_cast<uint8_t>(resolution);
+            memset(header.reserved, 0, sizeof(header.reserved));
+            memcpy(_file.data(), &header, sizeof(header));
+            _end = sizeof(JournalHeader);
+        }
+
+        ~Implementation()
+        {
+            close();
+        }
+
+        /// appends one record, the lock has to be held
+        void append(EventJournalRecord::Type type,
+                    timestamp_t log_time,
+                    timestamp_t simulation_time,
+                    logging::Category category,
+                    logging::Severity severity,
+                    tState state,
+                    const std::string& participant_name,
+                    const std::string& logger_name,
+                    const std::string& message)
+        {
+            if (_closed)
+            {
+                return;
+            }
+            RecordHeader record;
+            record.type = static_cast<uint8_t>(type);
+            record.severity = static_cast<uint8_t>(severity);
+            record.category = static_cast<uint8_t>(category);
+            record.state = static_cast<int8_t>(state);
+            record.log_time = log_time;
+            record.simulation_time = simulation_time;
+            record.participant_size = static_cast<uint16_t>(std::min<size_t>(participant_name.size(), UINT16_MAX));
+            record.logger_size = static_cast<uint16_t>(std::min<size_t>(logger_name.size(), UINT16_MAX));
+            record.message_size = static_cast<uint32_t>(std::min<size_t>(message.size(), UINT32_MAX / 2));
+            const uint64_t size = alignRecordSize(sizeof(RecordHeader)
+                + record.participant_size + record.logger_size + record.message_size);
+            record.size = static_cast<uint32_t>(size);
+            if (!reserve(size))
+            {
+                return;
+            }
+
+            char* target = _file.data() + _end;
+            memcpy(target, &record, sizeof(record));
+            target += sizeof(record);
+            memcpy(target, participant_name.data(), record.participant_size);
+            target += record.participant_size;
+            memcpy(target, logger_name.data(), record.logger_size);
+            target += record.logger_size;
+            memcpy(target, message.data(), record.message_size);
+            _end += size;
+            ++_record_count;
+        }
+
+        /// publishes the end of the appended records in the header, the lock has to be held
+        void commit()
+        {
+            if (_closed)
+            {
+                return;
+            }
+            auto& header = *reinterpret_cast<JournalHeader*>(_file.data());
+            // the records are complete before a reader of the mapping sees the new end
+            std::atomic_thread_fence(std::memory_order_release);
+            header.record_count = _record_count;
+            header.end = _end;
+        }
+
+        void close()
+        {
+            if (_closed)
+            {
+                return;
+            }
+            commit();
+            _closed = true;
+            _file.close(_end);
+        }
+
+        /// grows the mapping for @p size more bytes, closes the journal if it can not grow
+        bool reserve(uint64_t size)
+        {
+            if (_end + size <= _file.size())
+            {
+                return true;
+            }
+            commit();
+            uint64_t new_size = _file.size() + _chunk_size;
+            while (new_size < _end + size)
+            {
+                new_size += _chunk_size;
+            }
+            if (!_file.resize(new_size))
+            {
+                _closed = true;
+                _file.close(_end);
+                return false;
+            }
+            return true;
+        }
+
+        MappedFile _file;
+        const MonitorTimeResolution _resolution;
+        const size_t _chunk_size;
+        uint64_t _end = 0;
+        uint64_t _record_count = 0;
+        bool _closed = false;
+        mutable std::mutex _mutex;
+    };
+
+    EventRecorder::EventRecorder(const std::string& file_path, MonitorTimeResolution resolution, size_t chunk_size) :
+        _impl(new Implementation(file_path, resolution, chunk_size))
+    {
+    }
+
+    EventRecorder::~EventRecorder() = default;
+
+    void EventRecorder::onStateChanged(const std::string& participant, rpc::IRPCStateMachine::State state)
+    {
+        std::lock_guard<std::mutex> lock(_impl->_mutex);
+        _impl->append(EventJournalRecord::Type::state_changed, LogClock::get().now(_impl->_resolution), -1,
+            logging::CATEGORY_SYSTEM, logging::SEVERITY_INFO, state, participant, std::string(), std::string());
+        _impl->commit();
+    }
+
+    void EventRecorder::onNameChanged(const std::string& new_name, const std::string& old_name)
+    {
+        std::lock_guard<std::mutex> lock(_impl->_mutex);
+        _impl->append(EventJournalRecord::Type::name_changed, LogClock::get().now(_impl->_resolution), -1,
+            logging::CATEGORY_SYSTEM, logging::SEVERITY_INFO, FS_UNKNOWN, new_name, std::string(), old_name);
+        _impl->commit();
+    }
+
+    void EventRecorder::onLog(timestamp_t log_time,
+                              logging::Category category,
+                              logging::Severity severity_level,
+                              const std::string& participant_name,
+                              const std::string& logger_name,
+                              const std::string& message)
+    {
+        onLogWithSimulationTime(log_time, -1, category, severity_level, participant_name, logger_name, message);
+    }
+
+    void EventRecorder::onLogWithSimulationTime(timestamp_t log_time,
+                                                timestamp_t simulation_time,
+                                                logging::Category category,
+                                                logging::Severity severity_level,
+                                                const std::string& participant_name,
+                                                const std::string& logger_name,
+                                                const std::string& message)
+    {
+        std::lock_guard<std::mutex> lock(_impl->_mutex);
+        _impl->append(EventJournalRecord::Type::log, log_time, simulation_time, category, severity_level,
+            FS_UNKNOWN, participant_name, logger_name, message);
+        _impl->commit();
+    }
+
+    void EventRecorder::onLogBatch(const std::vector<std::shared_ptr<const MonitorLogRecord>>& records)
+    {
+        std::lock_guard<std::mutex> lock(_impl->_mutex);
+        for (const auto& record : records)
+        {
+            _impl->append(EventJournalRecord::Type::log, record->log_time, record->simulation_time,
+                record->category, record->severity_level, FS_UNKNOWN,
+                record->participant_name, record->logger_name, record->message);
+        }
+        _impl->commit();
+    }
+
+    void EventRecorder::onStateChangedBatch(const std::vector<MonitorStateRecord>& records)
+    {
+        const timestamp_t now = LogClock::get().now(_impl->_resolution);
+        std::lock_guard<std::mutex> lock(_impl->_mutex);
+        for (const auto& record : records)
+        {
+            _impl->append(EventJournalRecord::Type::state_changed, now, -1,
+                logging::CATEGORY_SYSTEM, logging::SEVERITY_INFO, record.state,
+                record.participant_name, std::string(), std::string());
+        }
+        _impl->commit();
+    }
+
+    void EventRecorder::flush()
+    {
+        std::lock_guard<std::mutex> lock(_impl->_mutex);
+        if (!_impl->_closed)
+        {
+            _impl->_file.flush();
+        }
+    }
+
+    void EventRecorder::close()
+    {
+        std::lock_guard<std::mutex> lock(_impl->_mutex);
+        _impl->close();
+    }
+
+    size_t EventRecorder::getRecordCount() const
+    {
+        std::lock_guard<std::mutex> lock(_impl->_mutex);
+        return static_cast<size_t>(_impl->_record_count);
+    }
+
+    struct EventJournalReader::Implementation
+    {
+        explicit Implementation(const std::string& file_path) :
+            _file_path(file_path)
+        {
+            std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+            if (!file)
+            {
+                throw std::runtime_error("the event journal " + file_path + " can not be opened");
+            }
+            const uint64_t file_size = static_cast<uint64_t>(file.tellg());
+            file.seekg(0);
+            JournalHeader header;
+            if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+                || memcmp(header.magic, journal_magic, sizeof(journal_magic)) != 0
+                || header.version != journal_version
+                || header.header_size < sizeof(JournalHeader))
+            {
+                throw std::runtime_error(file_path + " is no event journal");
+            }
+            _begin = header.header_size;
+            _resolution = header.time_resolution == static_cast<uint8_t>(MonitorTimeResolution::nanoseconds)
+                ? MonitorTimeResolution::nanoseconds : MonitorTimeResolution::microseconds;
+            // the end in the header may be behind the file of a crashed recorder, the records after it are not complete
+            _end = std::min(header.end, file_size);
+        }
+
+        std::string _file_path;
+        MonitorTimeResolution _resolution = MonitorTimeResolution::microseconds;
+        uint64_t _begin = 0;
+        uint64_t _end = 0;
+    };
+
+    EventJournalReader::EventJournalReader(const std::string& file_path) :
+        _impl(new Implementation(file_path))
+    {
+    }
+
+    EventJournalReader::~EventJournalReader() = default;
+
+    MonitorTimeResolution EventJournalReader::getTimeResolution() const
+    {
+        return _impl->_resolution;
+    }
+
+    size_t EventJournalReader::read(const EventJournalFilter& filter,
+                                    const std::function<bool(const EventJournalRecord&)>& callback) const
+    {
+        std::ifstream file(_impl->_file_path, std::ios::binary);
+        if (!file)
+        {
+            throw std::runtime_error("the event journal " + _impl->_file_path + " can not be opened");
+        }
+        size_t count = 0;
+        uint64_t position = _impl->_begin;
+        EventJournalRecord record;
+        RecordHeader header;
+        while (position + sizeof(RecordHeader) <= _impl->_end)
+        {
+            file.seekg(static_cast<std::streamoff>(position));
+            if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+                || header.size < sizeof(RecordHeader)
+                    + static_cast<uint64_t>(header.participant_size) + header.logger_size + header.message_size
+                || position + header.size > _impl->_end)
+            {
+                // a damaged record, the following records can not be found
+                break;
+            }
+            position += header.size;
+
+            const auto type = static_cast<EventJournalRecord::Type>(header.type);
+            const auto severity = static_cast<logging::Severity>(header.severity);
+            if (header.log_time < filter.begin_time || header.log_time > filter.end_time)
+            {
+                continue;
+            }
+            if (type == EventJournalRecord::Type::log
+                ? (severity == logging::SEVERITY_OFF || severity > filter.severity_level)
+                : !filter.include_state_changes)
+            {
+                continue;
+            }
+            record.participant_name.resize(header.participant_size);
+            if (header.participant_size > 0)
+            {
+                file.read(&record.participant_name[0], header.participant_size);
+            }
+            if (!filter.participant_name.empty() && record.participant_name != filter.participant_name)
+            {
+                continue;
+            }
+            record.logger_name.resize(header.logger_size);
+            if (header.logger_size > 0)
+            {
+                file.read(&record.logger_name[0], header.logger_size);
+            }
+            record.message.resize(header.message_size);
+            if (header.message_size > 0)
+            {
+                file.read(&record.message[0], header.message_size);
+            }
+            if (!file)
+            {
+                break;
+            }
+            record.type = type;
+            record.log_time = header.log_time;
+            record.simulation_time = header.simulation_time;
+            record.category = static_cast<logging::Category>(header.category);
+            record.severity_level = severity;
+            record.state = static_cast<tState>(header.state);
+            ++count;
+            if (!callback(record))
+            {
+                break;
+            }
+        }
+        return count;
+    }
+
+    std::vector<EventJournalRecord> EventJournalReader::read(const EventJournalFilter& filter) const
+    {
+        std::vector<EventJournalRecord> records;
+        read(filter, [&records](const EventJournalRecord& record)
+        {
+            records.push_back(record);
+            return true;
+        });
+        return records;
+    }
+}
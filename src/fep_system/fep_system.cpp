@@ -22,36 +22,38 @@
 #include "a_util/process.h"
 #include "connection_interface.h"
 #include "system_logger.h"
+#include "property_write_plan.h"
+#include "property_diff.h"
+#include "participant_tasks.h"
+#include "system_description.h"
+#include "configuration_snapshot.h"
+#include "property_path.h"
+#include "rpc_metrics.h"
+#include "trace_recorder.h"
+#include "membership_tracker.h"
 #include <map>
+#include <set>
 #include <mutex>
 #include <thread>
 #include <algorithm>
 #include <iterator>
+#include <fstream>
+#include <cmath>
 
 using namespace a_util::strings;
-namespace
-{
-    std::string replaceDotsWithSlashes(const std::string& initial_string)
-    {
-        std::string temp_string = initial_string;
-        std::replace(temp_string.begin(), temp_string.end(), '.', '/');
-        return temp_string;
-    }
-}
-
 namespace fep
 {
-    bool isParticipantStandalone(const ParticipantProxy& participant)
-    {      
-        auto configuration = participant.getRPCComponentProxy<fep::rpc::IRPCConfiguration>();
-        auto properties = configuration->getProperties(replaceDotsWithSlashes(FEP_COMPONENT_CONFIG_STATEMACHINE));
-        
-        bool standalone = DefaultPropertyTypeConversion<bool>::fromString(properties->getProperty(FEP_STM_STANDALONE_FIELD));
-        return standalone;
-    }
-
+    /**
+     * Checks the participants concurrently, the values are cached on the proxies (see ParticipantProxy::isStandalone)
+     */
     std::vector<std::string> getStandaloneParticipants(const std::vector<ParticipantProxy>& participants)
     {
+        const auto standalone = runForEachParticipant<bool>(participants,
+            [](const ParticipantProxy& participant)
+            {
+                return participant.isStandalone();
+            });
+
         std::vector<ParticipantProxy> standalone_participants;
         std::copy_if
             (participants.begin()
@@ -59,7 +61,7 @@ namespace fep
             , std::back_inserter(standalone_participants)
             , [&](ParticipantProxy const& participant)
                 {
-                    return isParticipantStandalone(participant);
+                    return standalone.at(participant.getName());
                 }
             );
 
@@ -81,7 +83,13 @@ namespace fep
     static constexpr int min_timeout = 500;
     static constexpr int timeout_divident = 10;
 
-    struct System::Implementation
+    std::map<std::string, tState> requestAvailableParticipants(AutomationInterface& ai, timestamp_t timeout_ms);
+    std::vector<std::string> getParticipantNames(const std::map<std::string, tState>& participants);
+    std::vector<std::string> filterBySystemName(AutomationInterface& ai,
+        const std::string& name,
+        const std::vector<std::string>& participants);
+
+    struct System::Implementation : public MembershipTracker::IMembers
     {
     public:
         explicit Implementation(std::string system_name) : _system_name(std::move(system_name))
@@ -101,12 +109,14 @@ namespace fep
 
         ~Implementation()
         {
+            stopMembershipTracking();
             unregisterMonitoring(nullptr);
             clear();
         }
 
         std::vector<std::string> mapToStringVec() const
         { 
+            std::lock_guard<std::recursive_mutex> lock(_participants_sync);
             std::vector<std::string> participants;
             for (const auto& p : _participants)
             {
@@ -117,6 +127,7 @@ namespace fep
 
         std::vector<ParticipantProxy> mapToProxyVec() const
         {
+            std::lock_guard<std::recursive_mutex> lock(_participants_sync);
             std::vector<ParticipantProxy> participants;
             for (const auto& p : _participants)
             {
@@ -125,13 +136,43 @@ namespace fep
             return participants;
         }
 
-        void trigger_participants(fep::tControlEvent ev, std::vector<std::string>& failed_ones) const
+        std::map<std::string, ParticipantProxy> getParticipantMap() const
         {
-            std::vector<ParticipantProxy> participants_in_order;
-            for (const auto& part : _participants)
+            std::lock_guard<std::recursive_mutex> lock(_participants_sync);
+            return _participants;
+        }
+
+        bool hasParticipants() const
+        {
+            std::lock_guard<std::recursive_mutex> lock(_participants_sync);
+            return !_participants.empty();
+        }
+
+        static const char* getTriggerSpanName(fep::tControlEvent ev)
+        {
+            switch (ev)
             {
-                participants_in_order.push_back(part.second);
+            case CE_Initialize:
+                return "trigger initialize";
+            case CE_Start:
+                return "trigger start";
+            case CE_Stop:
+                return "trigger stop";
+            case CE_Shutdown:
+                return "trigger shutdown";
+            case CE_ErrorFixed:
+                return "trigger error fixed";
+            case CE_Restart:
+                return "trigger restart";
+            default:
+                return "trigger";
             }
+        }
+
+        void trigger_participants(fep::tControlEvent ev, std::vector<std::string>& failed_ones) const
+        {
+            TraceScope trace("system", getTriggerSpanName(ev));
+            std::vector<ParticipantProxy> participants_in_order = mapToProxyVec();
             if (ev == fep::tControlEvent::CE_Initialize)
             {
                 std::sort(participants_in_order.begin(), participants_in_order.end(), 
@@ -151,11 +192,44 @@ namespace fep
                 );
             }
            
+            if (trace.isEnabled())
+            {
+                trace.setDetail(std::to_string(participants_in_order.size()) + " participants");
+            }
+            auto& timeline = _logger->getTransitionTimeline();
             for (const auto& part : participants_in_order)
             {
-                if (fep::isFailed(_coin.getAI().TriggerEvent(ev, part.getName().c_str())))
+                const std::string participant_name = part.getName();
+                timeline.recordTrigger(participant_name, ev);
+                RPCCallScope call(participant_name, "automation_interface", "TriggerEvent");
+                if (fep::isFailed(_coin.getAI().TriggerEvent(ev, participant_name.c_str())))
+                {
+                    call.setFailed();
+                    failed_ones.push_back(participant_name);
+                }
+                if (ev == CE_Shutdown || ev == CE_Restart)
                 {
-                    failed_ones.push_back(part.getName());
+                    part.invalidateCache();
+                }
+            }
+        }
+
+        /**
+         * The participants in these states may come up again as a new instance,
+         * so their cached values are discarded.
+         */
+        void invalidateRestartedParticipants(const std::map<std::string, fep::tState>& state_map) const
+        {
+            std::lock_guard<std::recursive_mutex> lock(_participants_sync);
+            for (const auto& p : state_map)
+            {
+                if (p.second == FS_STARTUP || p.second == FS_SHUTDOWN || p.second == FS_UNKNOWN)
+                {
+                    const auto participant = _participants.find(p.first);
+                    if (participant != _participants.end())
+                    {
+                        participant->second.invalidateCache();
+                    }
                 }
             }
         }
@@ -195,16 +269,39 @@ namespace fep
             }
 
             bool done = false;
+            size_t round = 0;
             std::map<std::string, fep::tState> state_map;
             while (!done)
             {
-                if (_participants.size() == 0)
+                if (!hasParticipants())
                 {
                     done = true;
                     break;
                 }
+                ++round;
+                TraceScope trace("system", "await_state round");
+                if (trace.isEnabled())
+                {
+                    trace.setDetail(std::string(cState::ToString(expected_state)) + " #" + std::to_string(round));
+                }
                 state_map.clear();
-                auto res = _coin.getAI().GetParticipantsState(state_map, mapToStringVec(), timeout_limiter);
+                fep::Result res;
+                {
+                    RPCCallScope call(RPCMetrics::getAnyParticipant(), "automation_interface", "GetParticipantsState");
+                    res = _coin.getAI().GetParticipantsState(state_map, mapToStringVec(), timeout_limiter);
+                    if (isFailed(res))
+                    {
+                        call.setFailed();
+                    }
+                }
+                for (const auto& p : state_map)
+                {
+                    if (p.second == expected_state)
+                    {
+                        _logger->getTransitionTimeline().recordArrival(p.first, p.second);
+                    }
+                }
+                invalidateRestartedParticipants(state_map);
 
                 if (states_are_ok(res, state_map, expected_state))
                 {
@@ -283,7 +380,8 @@ namespace fep
 
         void start(timestamp_t timeout_ms /*= FEP_SYSTEM_TRANSITION_TIME*/) const
         {
-            if (_participants.empty())
+            TraceScope trace("system", "start", _system_name);
+            if (!hasParticipants())
             {
                 _logger->log(logging::CATEGORY_SYSTEM, logging::SEVERITY_WARNING, "",
                     _system_name, "No participants within the current system");
@@ -322,7 +420,8 @@ namespace fep
 
         void stop(timestamp_t timeout_ms /*= FEP_SYSTEM_TRANSTI*/) const
         {
-            if (_participants.empty())
+            TraceScope trace("system", "stop", _system_name);
+            if (!hasParticipants())
             {
                 _logger->log(logging::CATEGORY_SYSTEM, logging::SEVERITY_WARNING, "",
                     _system_name, "No participants within the current system");
@@ -347,7 +446,8 @@ namespace fep
 
         void shutdown(timestamp_t timeout_ms /*= FEP_SYSTEM_TRANSTI*/) const
         {
-            if (_participants.empty())
+            TraceScope trace("system", "shutdown", _system_name);
+            if (!hasParticipants())
             {
                 _logger->log(logging::CATEGORY_SYSTEM, logging::SEVERITY_WARNING, "",
                     _system_name, "No participants within the current system");
@@ -379,9 +479,11 @@ namespace fep
         {
             System::State state;
             auto vec = mapToStringVec();
+            RPCCallScope call(RPCMetrics::getAnyParticipant(), "automation_interface", "GetSystemState");
             auto res = _coin.getAI().GetSystemState(state, vec, timeout_ms);
             if (isFailed(res))
             {
+                call.setFailed();
                 _logger->log(logging::CATEGORY_SYSTEM, logging::SEVERITY_FATAL, "", _system_name,
                     "System state couldn't be determined. Is the system empty?");
                 throw std::runtime_error{ "System state couldn't be determined" };
@@ -389,9 +491,11 @@ namespace fep
             return state;
         }
 
-        void registerMonitoring(IEventMonitor* pMonitor)
+        void registerMonitoring(IEventMonitor* pMonitor,
+                                const MonitorFilter& filter = MonitorFilter(),
+                                const MonitorBatchOptions& batching = MonitorBatchOptions())
         {
-            _logger->registerMonitor(pMonitor, _system_name);
+            _logger->registerMonitor(pMonitor, filter, batching, _system_name);
         }
 
         void unregisterMonitoring(IEventMonitor* pMonitor)
@@ -404,35 +508,104 @@ namespace fep
             _logger->setSeverityLevel(level);
         }
 
+        void setMonitoringQueue(size_t capacity, MonitorOverflowPolicy policy)
+        {
+            _logger->setMonitoringQueue(capacity, policy);
+        }
+
+        void setMonitoringTimeResolution(MonitorTimeResolution resolution)
+        {
+            _logger->setMonitoringTimeResolution(resolution);
+        }
+
+        void setIncidentRateLimit(const IncidentRateLimit& limit)
+        {
+            _logger->setIncidentRateLimit(limit);
+        }
+
+        std::vector<TransitionEvent> getTransitionTimeline() const
+        {
+            return _logger->getTransitionTimeline().getTimeline();
+        }
+
+        std::vector<TransitionLatency> getTransitionLatencies() const
+        {
+            return _logger->getTransitionTimeline().getLatencies();
+        }
+
+        void dumpTransitionLatencies(const std::string& file_path) const
+        {
+            std::ofstream file(file_path, std::ios::trunc);
+            if (!file)
+            {
+                throw std::runtime_error("the transition latencies can not be written to " + file_path);
+            }
+            file << "participant,transition,count,min_us,p50_us,p95_us,p99_us,max_us\n";
+            for (const auto& latency : getTransitionLatencies())
+            {
+                file << latency.participant_name << "," << latency.transition << "," << latency.count << ","
+                    << latency.min << "," << latency.p50 << "," << latency.p95 << ","
+                    << latency.p99 << "," << latency.max << "\n";
+            }
+            if (!file.flush())
+            {
+                throw std::runtime_error("the transition latencies can not be written to " + file_path);
+            }
+        }
+
+        void clearTransitionLatencies()
+        {
+            _logger->getTransitionTimeline().clear();
+        }
+
         bool getAvailableParticipants(std::map<std::string, tState>& participant_map, const timestamp_t& timeout_ms)
         {
-            _coin.getAI().GetAvailableParticipants(participant_map,
-                timeout_ms);
+            RPCCallScope call(RPCMetrics::getAnyParticipant(), "automation_interface", "GetAvailableParticipants");
+            if (isFailed(_coin.getAI().GetAvailableParticipants(participant_map, timeout_ms)))
+            {
+                call.setFailed();
+            }
             return true;
         }
 
         void clear()
         {
+            std::lock_guard<std::recursive_mutex> lock(_participants_sync);
             _participants.clear();
         }
 
-        void add(const std::string& participant)
+        ParticipantProxy createProxy(const std::string& participant) const
         {
-            _participants[participant] = ParticipantProxy(participant,
+            return ParticipantProxy(participant,
                 _system_name,
                 *_logger.get(),
                 PARTICIPANT_DEFAULT_TIMEOUT);
         }
 
+        void add(const std::string& participant)
+        {
+            //the proxy connects the participant, so it is created outside of the lock
+            auto proxy = createProxy(participant);
+            std::lock_guard<std::recursive_mutex> lock(_participants_sync);
+            _participants[participant] = proxy;
+        }
+
         void remove(const std::string& participant)
         {
+            std::lock_guard<std::recursive_mutex> lock(_participants_sync);
             _participants.erase(participant);
         }
 
         void rename(const std::string& old_participant_name,
             const std::string& new_participant_name, timestamp_t timeout_ms /*= PARTICIPANT_DEFAULT_TIMEOUT*/) const
         {
-            if (isOk(_coin.getAI().RenameParticipant(new_participant_name, old_participant_name, timeout_ms)))
+            RPCCallScope call(old_participant_name, "automation_interface", "RenameParticipant");
+            const auto res = _coin.getAI().RenameParticipant(new_participant_name, old_participant_name, timeout_ms);
+            if (isFailed(res))
+            {
+                call.setFailed();
+            }
+            if (isOk(res))
             {
                 _logger->log(logging::CATEGORY_SYSTEM, logging::SEVERITY_INFO, "",
                     _system_name, "Participant successfully renamed");
@@ -441,10 +614,13 @@ namespace fep
 
         ParticipantProxy getParticipant(const std::string& participant_name) const
         {
-            auto p = _participants.find(participant_name);
-            if (p != _participants.end())
             {
-                return p->second;
+                std::lock_guard<std::recursive_mutex> lock(_participants_sync);
+                auto p = _participants.find(participant_name);
+                if (p != _participants.end())
+                {
+                    return p->second;
+                }
             }
             _logger->log(logging::CATEGORY_SYSTEM, logging::SEVERITY_FATAL, "", _system_name,
                 "No Participant with the name " + participant_name + " found");
@@ -456,114 +632,361 @@ namespace fep
             return mapToProxyVec();
         }
 
-        void setPropertyValue(const std::string& participant,
-            const std::string& node,
-            const std::string& property_name,
-            const std::string& value,
-            const std::string& type) const
+        void addTimingConfiguration(PropertyWritePlan& plan,
+            const std::string& master_clock_name, const std::string& slave_clock_name,
+            const std::string& scheduler, const std::string& master_element_id, const std::string& master_time_stepsize,
+            const std::string& master_time_factor, const std::string& slave_sync_cycle_time) const
         {
-            const auto property_normalized = replaceDotsWithSlashes(property_name);
+            plan.addToAll("/", FEP_TIMING_MASTER_PARTICIPANT, master_element_id, fep::PropertyType<std::string>::getTypeName());
+            plan.addToAll("/", FEP_SCHEDULERSERVICE_SCHEDULER, scheduler, fep::PropertyType<std::string>::getTypeName());
 
-            auto part = getParticipant(participant);
-            if (part)
+            if (!master_element_id.empty())
             {
-                auto config_rpc_client = part.getRPCComponentProxy<fep::rpc::IRPCConfiguration>();
-                auto props = config_rpc_client->getProperties(node);
-                if (!props)
+                plan.addToAll("/", FEP_CLOCKSERVICE_MAIN_CLOCK, slave_clock_name, fep::PropertyType<std::string>::getTypeName(), master_element_id);
+                plan.addTo(master_element_id, "/", FEP_CLOCKSERVICE_MAIN_CLOCK, master_clock_name, fep::PropertyType<std::string>::getTypeName());
+                if (!master_time_factor.empty())
                 {
-                    throw std::runtime_error(format("access to properties node %s not possible", node));
+                    plan.addTo(master_element_id, "/", FEP_CLOCKSERVICE_MAIN_CLOCK_SIM_TIME_TIME_FACTOR, master_time_factor, fep::PropertyType<double>::getTypeName());
                 }
+                if (!master_time_stepsize.empty())
+                {
+                    plan.addTo(master_element_id, "/", FEP_CLOCKSERVICE_MAIN_CLOCK_SIM_TIME_CYCLE_TIME, master_time_stepsize, fep::PropertyType<int32_t>::getTypeName());
+                }
+                if (!slave_sync_cycle_time.empty())
+                {
+                    plan.addToAll("/", FEP_CLOCKSERVICE_SLAVE_SYNC_CYCLE_TIME, slave_sync_cycle_time, fep::PropertyType<int32_t>::getTypeName(), master_element_id);
+                }
+            }
+            else
+            {
+                plan.addToAll("/", FEP_CLOCKSERVICE_MAIN_CLOCK, slave_clock_name, fep::PropertyType<std::string>::getTypeName());
+            }
+        }
 
-                if (!props->setProperty(property_normalized, value, type))
-                {                           
-                    const auto message = format("property %s could not be set for the following participant: %s"
-                        , property_normalized.c_str()
-                        , part.getName().c_str());
-
-                    throw std::runtime_error(message);
-                }                              
+        void addTimingMode(PropertyWritePlan& plan, const TimingDescription& timing) const
+        {
+            const auto& master = timing.master_element_id;
+            if (timing.mode == timing_mode::custom)
+            {
+                addTimingConfiguration(plan, timing.master_clock_name, timing.slave_clock_name, timing.scheduler, master,
+                    timing.master_time_stepsize, timing.master_time_factor, timing.slave_sync_cycle_time);
+            }
+            else if (timing.mode == timing_mode::fep2_system_time)
+            {
+                plan.addTo(master, "/", FEP_TIMING_MASTER_TRIGGER_MODE, "SYSTEM_TIME", fep::PropertyType<std::string>::getTypeName());
+                plan.addTo(master, "/", FEP_TIMING_MASTER_TIME_FACTOR, timing.master_time_factor, fep::PropertyType<double>::getTypeName());
+                addTimingConfiguration(plan, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_MASTER_LOCKED_STEP_SIMTIME, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_MASTER_LOCKED_STEP_SIMTIME,
+                    FEP_SCHEDULERSERVICE_SCHEDULER_VALUE_MASTER_LOCKED_STEP_SIMTIME, master, "", "", "");
+            }
+            else if (timing.mode == timing_mode::fep2_no_master)
+            {
+                addTimingConfiguration(plan, "", FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_MASTER_LOCKED_STEP_SIMTIME,
+                    FEP_SCHEDULERSERVICE_SCHEDULER_VALUE_MASTER_LOCKED_STEP_SIMTIME, "", "", "", "");
+            }
+            else if (timing.mode == timing_mode::fep2_afap)
+            {
+                plan.addTo(master, "/", FEP_TIMING_MASTER_TRIGGER_MODE, "AFAP", fep::PropertyType<std::string>::getTypeName());
+                addTimingConfiguration(plan, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_MASTER_LOCKED_STEP_SIMTIME, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_MASTER_LOCKED_STEP_SIMTIME,
+                    FEP_SCHEDULERSERVICE_SCHEDULER_VALUE_MASTER_LOCKED_STEP_SIMTIME, master, "", "", "");
+            }
+            else if (timing.mode == timing_mode::fep3_no_master)
+            {
+                addTimingConfiguration(plan, "", FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_LOCAL_SYSTEM_REAL_TIME,
+                    FEP_SCHEDULERSERVICE_SCHEDULER_VALUE_CLOCK_BASED, "", "", "", "");
+            }
+            else if (timing.mode == timing_mode::fep3_clock_sync_only_interpolation)
+            {
+                addTimingConfiguration(plan, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_LOCAL_SYSTEM_REAL_TIME, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_SLAVE_MASTER_ONDEMAND,
+                    FEP_SCHEDULERSERVICE_SCHEDULER_VALUE_CLOCK_BASED, master, "", "", timing.slave_sync_cycle_time);
+            }
+            else if (timing.mode == timing_mode::fep3_clock_sync_only_discrete)
+            {
+                addTimingConfiguration(plan, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_LOCAL_SYSTEM_REAL_TIME, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_SLAVE_MASTER_ONDEMAND_DISCRETE,
+                    FEP_SCHEDULERSERVICE_SCHEDULER_VALUE_CLOCK_BASED, master, "", "", timing.slave_sync_cycle_time);
+            }
+            else if (timing.mode == timing_mode::fep3_discrete_steps)
+            {
+                addTimingConfiguration(plan, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_LOCAL_SYSTEM_SIM_TIME, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_SLAVE_MASTER_ONDEMAND_DISCRETE,
+                    FEP_SCHEDULERSERVICE_SCHEDULER_VALUE_CLOCK_BASED, master, timing.master_time_stepsize, timing.master_time_factor, "");
+            }
+            else if (timing.mode == timing_mode::fep3_afap)
+            {
+                addTimingConfiguration(plan, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_LOCAL_SYSTEM_SIM_TIME, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_SLAVE_MASTER_ONDEMAND_DISCRETE,
+                    FEP_SCHEDULERSERVICE_SCHEDULER_VALUE_CLOCK_BASED, master, timing.master_time_stepsize, "0.0", "");
             }
             else
             {
-                throw std::runtime_error(format("participant %s within system %s not found to configure %s",
-                    participant.c_str(),
-                    _system_name.c_str(),
-                    property_normalized.c_str()));
+                throw std::runtime_error{ "unknown timing mode " + timing.mode };
             }
         }
 
-        void setPropertyValueToAll(const std::string& node,
-            const std::string& property_name,
-            const std::string& value,
-            const std::string& type,
-            const std::string& except_participant = std::string()) const
+        void configureTimingMode(const TimingDescription& timing) const
         {
-            const auto property_normalized = replaceDotsWithSlashes(property_name);
-            auto failing_participants = std::vector<std::string>();
+            PropertyWritePlan plan;
+            addTimingMode(plan, timing);
+            applyPlan(plan);
+        }
 
-            for (fep::ParticipantProxy participant : getParticipants())
+        void applyPlan(const PropertyWritePlan& plan) const
+        {
+            const auto participants = getParticipantMap();
+            // fail before anything is written if a single addressed participant is not part of the system
+            for (const auto& participant : plan.getAddressedParticipants())
             {
-                if (!except_participant.empty())
+                if (participants.find(participant.first) == participants.end())
                 {
-                    if (participant.getName() == except_participant)
-                    {
-                        continue;
-                    }
+                    _logger->log(logging::CATEGORY_SYSTEM, logging::SEVERITY_FATAL, "", _system_name,
+                        "No Participant with the name " + participant.first + " found");
+                    throw std::runtime_error(format("participant %s within system %s not found to configure %s",
+                        participant.first.c_str(),
+                        _system_name.c_str(),
+                        participant.second.c_str()));
                 }
-                auto config_rpc_client = participant.getRPCComponentProxy<fep::rpc::IRPCConfiguration>();
-                auto props = config_rpc_client->getProperties(node);
-                if (props)
+            }
+            plan.execute(participants);
+        }
+
+        std::vector<PropertyChange> applyConfiguration(const SystemConfiguration& desired) const
+        {
+            std::vector<ParticipantProxy> participants_to_read;
+            for (const auto& participant_configuration : desired)
+            {
+                participants_to_read.push_back(getParticipant(participant_configuration.first));
+            }
+
+            //the configuration proxy resolved for the read is used for the write as well
+            struct ParticipantDiff
+            {
+                rpc_component<rpc::IRPCConfiguration> configuration;
+                std::vector<PropertyChange> changes;
+            };
+            const auto diffs = runForEachParticipant<ParticipantDiff>(participants_to_read,
+                [&desired](const ParticipantProxy& participant)
                 {
-                    auto success = props->setProperty(property_normalized, value, type);
-                    if (!success)
-                    {
-                        failing_participants.push_back(participant.getName());
-                    }
+                    ParticipantDiff diff;
+                    diff.configuration = participant.getRPCComponentProxy<fep::rpc::IRPCConfiguration>();
+                    diff.changes = diffParticipantConfiguration(participant.getName(), diff.configuration,
+                        desired.at(participant.getName()));
+                    return diff;
+                });
+
+            PropertyWritePlan plan;
+            std::map<std::string, rpc_component<rpc::IRPCConfiguration>> configurations;
+            std::vector<PropertyChange> changes;
+            for (const auto& diff : diffs)
+            {
+                configurations[diff.first] = diff.second.configuration;
+                for (const auto& change : diff.second.changes)
+                {
+                    const auto node_and_name = splitPropertyPath(change.path);
+                    plan.addTo(change.participant, node_and_name.first, node_and_name.second, change.new_value, change.type);
+                    changes.push_back(change);
                 }
-            }                       
-
-            if (failing_participants.size() > 0)
+            }
+            if (!plan.empty())
             {
-                auto paritipants = join(failing_participants, ", ");
-                auto message = format("property %s could not be set for the following participants: %s"
-                    , property_normalized.c_str()
-                    , paritipants.c_str());
+                plan.execute(getParticipantMap(), configurations);
+            }
 
-                throw std::runtime_error(message);
-            }           
+            _logger->logLazy(logging::CATEGORY_SYSTEM, logging::SEVERITY_INFO, "", _system_name,
+                [&]() { return format("configuration applied, %d properties changed", static_cast<int>(changes.size())); });
+            return changes;
         }
 
-        void configureTiming(const std::string& master_clock_name, const std::string& slave_clock_name,
-            const std::string& scheduler, const std::string& master_element_id, const std::string& master_time_stepsize,
-            const std::string& master_time_factor, const std::string& slave_sync_cycle_time) const
+        SystemConfiguration snapshotConfiguration() const
         {
-            setPropertyValueToAll("/", FEP_TIMING_MASTER_PARTICIPANT, master_element_id, fep::PropertyType<std::string>::getTypeName());
-            setPropertyValueToAll("/", FEP_SCHEDULERSERVICE_SCHEDULER, scheduler, fep::PropertyType<std::string>::getTypeName());
+            return runForEachParticipant<ParticipantConfiguration>(mapToProxyVec(),
+                [](const ParticipantProxy& participant)
+                {
+                    return snapshotParticipantConfiguration(participant);
+                });
+        }
 
-            if (!master_element_id.empty())
+        void snapshotConfiguration(const std::string& file_path) const
+        {
+            const auto snapshot = snapshotConfiguration();
+            configuration_snapshot::write(file_path, snapshot);
+            _logger->logLazy(logging::CATEGORY_SYSTEM, logging::SEVERITY_INFO, "", _system_name,
+                [&]() { return format("configuration snapshot %s written", file_path.c_str()); });
+        }
+
+        std::vector<PropertyChange> restoreConfiguration(const std::string& file_path) const
+        {
+            SystemConfiguration snapshot;
+            try
             {
-                setPropertyValueToAll("/", FEP_CLOCKSERVICE_MAIN_CLOCK, slave_clock_name, fep::PropertyType<std::string>::getTypeName(), master_element_id);
-                setPropertyValue(master_element_id, "/", FEP_CLOCKSERVICE_MAIN_CLOCK, master_clock_name, fep::PropertyType<std::string>::getTypeName());
-                if (!master_time_factor.empty())
+                snapshot = configuration_snapshot::read(file_path);
+            }
+            catch (const std::runtime_error& ex)
+            {
+                _logger->log(logging::CATEGORY_SYSTEM, logging::SEVERITY_FATAL, "", _system_name, ex.what());
+                throw;
+            }
+            return applyConfiguration(snapshot);
+        }
+
+        std::vector<PropertyChange> loadConfiguration(const std::string& file_path)
+        {
+            SystemDescription description;
+            try
+            {
+                description = SystemDescriptionReader().read(file_path);
+            }
+            catch (const std::runtime_error& ex)
+            {
+                _logger->log(logging::CATEGORY_SYSTEM, logging::SEVERITY_FATAL, "", _system_name, ex.what());
+                throw;
+            }
+
+            // fail before anything is written if the file addresses participants which are not part of the system
+            auto participants = getParticipantMap();
+            std::vector<std::string> unknown_participants;
+            for (const auto& participant : description.participants)
+            {
+                if (participants.find(participant.first) == participants.end())
                 {
-                    setPropertyValue(master_element_id, "/", FEP_CLOCKSERVICE_MAIN_CLOCK_SIM_TIME_TIME_FACTOR, master_time_factor, fep::PropertyType<double>::getTypeName());
+                    unknown_participants.push_back(participant.first);
                 }
-                if (!master_time_stepsize.empty())
+            }
+            const auto& master = description.timing.master_element_id;
+            if (!master.empty() && participants.find(master) == participants.end())
+            {
+                unknown_participants.push_back(master);
+            }
+            if (!unknown_participants.empty())
+            {
+                const auto message = format("configuration file %s addresses participants which are not part of the system: %s",
+                    file_path.c_str(), join(unknown_participants, ", ").c_str());
+                _logger->log(logging::CATEGORY_SYSTEM, logging::SEVERITY_FATAL, "", _system_name, message);
+                throw std::runtime_error{ message };
+            }
+
+            SystemConfiguration desired;
+            for (auto& participant : participants)
+            {
+                auto& participant_configuration = desired[participant.first];
+                participant_configuration = description.properties;
+                const auto participant_description = description.participants.find(participant.first);
+                if (participant_description == description.participants.end())
                 {
-                    setPropertyValue(master_element_id, "/", FEP_CLOCKSERVICE_MAIN_CLOCK_SIM_TIME_CYCLE_TIME, master_time_stepsize, fep::PropertyType<int32_t>::getTypeName());
+                    continue;
                 }
-                if (!slave_sync_cycle_time.empty())
+                for (const auto& property : participant_description->second.properties)
+                {
+                    participant_configuration[property.first] = property.second;
+                }
+                if (participant_description->second.has_init_priority)
+                {
+                    participant.second.setInitPriority(participant_description->second.init_priority);
+                }
+                if (participant_description->second.has_start_priority)
                 {
-                    setPropertyValueToAll("/", FEP_CLOCKSERVICE_SLAVE_SYNC_CYCLE_TIME, slave_sync_cycle_time, fep::PropertyType<int32_t>::getTypeName(), master_element_id);
+                    participant.second.setStartPriority(participant_description->second.start_priority);
                 }
             }
-            else
+
+            if (description.has_timing)
+            {
+                configureTimingMode(description.timing);
+            }
+            auto changes = applyConfiguration(desired);
+
+            _logger->logLazy(logging::CATEGORY_SYSTEM, logging::SEVERITY_INFO, "", _system_name,
+                [&]() { return format("configuration file %s loaded", file_path.c_str()); });
+            return changes;
+        }
+
+        void configureTiming(const std::string& master_clock_name, const std::string& slave_clock_name,
+            const std::string& scheduler, const std::string& master_element_id, const std::string& master_time_stepsize,
+            const std::string& master_time_factor, const std::string& slave_sync_cycle_time) const
+        {
+            PropertyWritePlan plan;
+            addTimingConfiguration(plan, master_clock_name, slave_clock_name, scheduler, master_element_id,
+                master_time_stepsize, master_time_factor, slave_sync_cycle_time);
+            applyPlan(plan);
+        }
+
+        void startMembershipTracking(const MembershipTrackingOptions& options)
+        {
+            std::lock_guard<std::mutex> lock(_tracker_sync);
+            _tracker.reset();
+            _tracker.reset(new MembershipTracker(*this, _coin.getAI(), options));
+        }
+
+        void stopMembershipTracking()
+        {
+            std::lock_guard<std::mutex> lock(_tracker_sync);
+            _tracker.reset();
+        }
+
+        bool isMembershipTracked() const
+        {
+            std::lock_guard<std::mutex> lock(_tracker_sync);
+            return static_cast<bool>(_tracker);
+        }
+
+        std::vector<std::string> getMemberNames() const override
+        {
+            return mapToStringVec();
+        }
+
+        std::vector<std::string> discoverMembers(const MembershipTrackingOptions& options) override
+        {
+            return getParticipantNames(requestAvailableParticipants(_coin.getAI(), options.discover_time_ms));
+        }
+
+        bool addMember(const std::string& participant_name, const MembershipTrackingOptions& options) override
+        {
+            if (options.filter_by_system_name
+                && filterBySystemName(_coin.getAI(), _system_name, { participant_name }).empty())
+            {
+                return false;
+            }
+            //connected and the cached values read before it is visible in the system
+            auto proxy = createProxy(participant_name);
+            if (proxy.isStandalone())
             {
-                setPropertyValueToAll("/", FEP_CLOCKSERVICE_MAIN_CLOCK, slave_clock_name, fep::PropertyType<std::string>::getTypeName());
+                return false;
             }
+            std::lock_guard<std::recursive_mutex> lock(_participants_sync);
+            _participants[participant_name] = proxy;
+            return true;
+        }
+
+        void removeMember(const std::string& participant_name) override
+        {
+            remove(participant_name);
+        }
+
+        bool refreshMember(const std::string& participant_name) override
+        {
+            ParticipantProxy proxy;
+            {
+                std::lock_guard<std::recursive_mutex> lock(_participants_sync);
+                auto participant = _participants.find(participant_name);
+                if (participant == _participants.end())
+                {
+                    return true;
+                }
+                proxy = participant->second;
+            }
+            //refreshed in place, so the property listeners registered through the proxy are kept
+            proxy.invalidateCache();
+            return !proxy.isStandalone();
+        }
+
+        void notifyMembership(const std::string& participant_name, bool added) override
+        {
+            _logger->log(logging::CATEGORY_SYSTEM, logging::SEVERITY_INFO, "", _system_name,
+                "Participant " + participant_name + (added ? " was added to" : " was removed from")
+                + " the system by the membership tracking");
+            _logger->pushMembershipChanged(participant_name, added);
         }
 
         std::map<std::string, ParticipantProxy> _participants;
+        mutable std::recursive_mutex _participants_sync;
+        std::unique_ptr<MembershipTracker> _tracker;
+        mutable std::mutex _tracker_sync;
         ConnectionInterface _coin;
         std::shared_ptr<SystemLogger> _logger = std::make_shared<SystemLogger>();
         std::string _system_name;
@@ -693,6 +1116,18 @@ namespace fep
         _impl->registerMonitoring(&pEventListener);
     }
 
+    void System::registerMonitoring(IEventMonitor& pEventListener, const MonitorFilter& filter)
+    {
+        _impl->registerMonitoring(&pEventListener, filter);
+    }
+
+    void System::registerMonitoring(IEventMonitor& pEventListener,
+                                    const MonitorFilter& filter,
+                                    const MonitorBatchOptions& batching)
+    {
+        _impl->registerMonitoring(&pEventListener, filter, batching);
+    }
+
     void System::unregisterMonitoring(IEventMonitor& pEventListener)
     {
         _impl->unregisterMonitoring(&pEventListener);
@@ -703,6 +1138,56 @@ namespace fep
         _impl->setSeverityLevel(severity_level);
     }
 
+    void System::setMonitoringQueue(size_t capacity, MonitorOverflowPolicy policy)
+    {
+        _impl->setMonitoringQueue(capacity, policy);
+    }
+
+    void System::setMonitoringTimeResolution(MonitorTimeResolution resolution)
+    {
+        _impl->setMonitoringTimeResolution(resolution);
+    }
+
+    void System::setIncidentRateLimit(const IncidentRateLimit& limit)
+    {
+        _impl->setIncidentRateLimit(limit);
+    }
+
+    std::vector<TransitionEvent> System::getTransitionTimeline() const
+    {
+        return _impl->getTransitionTimeline();
+    }
+
+    std::vector<TransitionLatency> System::getTransitionLatencies() const
+    {
+        return _impl->getTransitionLatencies();
+    }
+
+    void System::dumpTransitionLatencies(const std::string& file_path) const
+    {
+        _impl->dumpTransitionLatencies(file_path);
+    }
+
+    void System::clearTransitionLatencies()
+    {
+        _impl->clearTransitionLatencies();
+    }
+
+    void System::startMembershipTracking(const MembershipTrackingOptions& options)
+    {
+        _impl->startMembershipTracking(options);
+    }
+
+    void System::stopMembershipTracking()
+    {
+        _impl->stopMembershipTracking();
+    }
+
+    bool System::isMembershipTracked() const
+    {
+        return _impl->isMembershipTracked();
+    }
+
     void System::configureTiming(const std::string& master_clock_name, const std::string& slave_clock_name,
         const std::string& scheduler, const std::string& master_element_id, const std::string& master_time_stepsize,
         const std::string& master_time_factor, const std::string& slave_sync_cycle_time) const
@@ -713,84 +1198,274 @@ namespace fep
 
     void System::configureTiming2SystemTime(const std::string& master_element_id, const std::string& master_time_factor) const
     {
-        _impl->setPropertyValue(master_element_id, "/", FEP_TIMING_MASTER_TRIGGER_MODE, "SYSTEM_TIME", fep::PropertyType<std::string>::getTypeName());
-        _impl->setPropertyValue(master_element_id, "/", FEP_TIMING_MASTER_TIME_FACTOR, master_time_factor, fep::PropertyType<double>::getTypeName());
-        _impl->configureTiming(FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_MASTER_LOCKED_STEP_SIMTIME, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_MASTER_LOCKED_STEP_SIMTIME, 
-            FEP_SCHEDULERSERVICE_SCHEDULER_VALUE_MASTER_LOCKED_STEP_SIMTIME, master_element_id, "", "", "");
+        _impl->configureTimingMode({ timing_mode::fep2_system_time, master_element_id, "", master_time_factor, "" });
     }
 
     void System::configureTiming2NoMaster() const
     {
-        _impl->configureTiming("", FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_MASTER_LOCKED_STEP_SIMTIME, 
-            FEP_SCHEDULERSERVICE_SCHEDULER_VALUE_MASTER_LOCKED_STEP_SIMTIME, "", "", "", "");
+        _impl->configureTimingMode({ timing_mode::fep2_no_master, "", "", "", "" });
     }
 
     void System::configureTiming2AFAP(const std::string& master_element_id) const
     {
-        _impl->setPropertyValue(master_element_id, "/", FEP_TIMING_MASTER_TRIGGER_MODE, "AFAP", fep::PropertyType<std::string>::getTypeName());
-        _impl->configureTiming(FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_MASTER_LOCKED_STEP_SIMTIME, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_MASTER_LOCKED_STEP_SIMTIME, 
-            FEP_SCHEDULERSERVICE_SCHEDULER_VALUE_MASTER_LOCKED_STEP_SIMTIME, master_element_id, "", "", "");
+        _impl->configureTimingMode({ timing_mode::fep2_afap, master_element_id, "", "", "" });
     }
 
     void System::configureTiming3NoMaster() const
     {
-        _impl->configureTiming("", FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_LOCAL_SYSTEM_REAL_TIME, 
-            FEP_SCHEDULERSERVICE_SCHEDULER_VALUE_CLOCK_BASED, "", "", "", "");
+        _impl->configureTimingMode({ timing_mode::fep3_no_master, "", "", "", "" });
     }
 
     void System::configureTiming3ClockSyncOnlyInterpolation(const std::string& master_element_id, const std::string& slave_sync_cycle_time) const
     {
-        _impl->configureTiming(FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_LOCAL_SYSTEM_REAL_TIME, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_SLAVE_MASTER_ONDEMAND, 
-            FEP_SCHEDULERSERVICE_SCHEDULER_VALUE_CLOCK_BASED, master_element_id, "", "", slave_sync_cycle_time);
+        _impl->configureTimingMode({ timing_mode::fep3_clock_sync_only_interpolation, master_element_id, "", "", slave_sync_cycle_time });
     }
 
     void System::configureTiming3ClockSyncOnlyDiscrete(const std::string& master_element_id, const std::string& slave_sync_cycle_time) const
     {
-        _impl->configureTiming(FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_LOCAL_SYSTEM_REAL_TIME, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_SLAVE_MASTER_ONDEMAND_DISCRETE, 
-            FEP_SCHEDULERSERVICE_SCHEDULER_VALUE_CLOCK_BASED, master_element_id, "", "", slave_sync_cycle_time);
+        _impl->configureTimingMode({ timing_mode::fep3_clock_sync_only_discrete, master_element_id, "", "", slave_sync_cycle_time });
     }
 
     void System::configureTiming3DiscreteSteps(const std::string& master_element_id, const std::string& master_time_stepsize, const std::string& master_time_factor) const
     {
-        _impl->configureTiming(FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_LOCAL_SYSTEM_SIM_TIME, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_SLAVE_MASTER_ONDEMAND_DISCRETE, 
-            FEP_SCHEDULERSERVICE_SCHEDULER_VALUE_CLOCK_BASED, master_element_id, master_time_stepsize, master_time_factor, "");
+        _impl->configureTimingMode({ timing_mode::fep3_discrete_steps, master_element_id, master_time_stepsize, master_time_factor, "" });
     }
 
     void System::configureTiming3AFAP(const std::string& master_element_id, const std::string& master_time_stepsize) const
     {
-        _impl->configureTiming(FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_LOCAL_SYSTEM_SIM_TIME, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_SLAVE_MASTER_ONDEMAND_DISCRETE, 
-            FEP_SCHEDULERSERVICE_SCHEDULER_VALUE_CLOCK_BASED, master_element_id, master_time_stepsize, "0.0", "");
+        _impl->configureTimingMode({ timing_mode::fep3_afap, master_element_id, master_time_stepsize, "", "" });
+    }
+
+    std::vector<PropertyChange> System::applyConfiguration(const SystemConfiguration& desired) const
+    {
+        return _impl->applyConfiguration(desired);
+    }
+
+    std::vector<PropertyChange> System::loadConfiguration(const std::string& file_path)
+    {
+        return _impl->loadConfiguration(file_path);
+    }
+
+    SystemConfiguration System::snapshotConfiguration() const
+    {
+        return _impl->snapshotConfiguration();
+    }
+
+    void System::snapshotConfiguration(const std::string& file_path) const
+    {
+        _impl->snapshotConfiguration(file_path);
+    }
+
+    std::vector<PropertyChange> System::restoreConfiguration(const SystemConfiguration& snapshot) const
+    {
+        return _impl->applyConfiguration(snapshot);
+    }
+
+    std::vector<PropertyChange> System::restoreConfiguration(const std::string& file_path) const
+    {
+        return _impl->restoreConfiguration(file_path);
     }
 
 /**************************************************************
 * discoveries 
 ***************************************************************/
 
+    std::map<std::string, tState> requestAvailableParticipants(AutomationInterface& ai, timestamp_t timeout_ms)
+    {
+        std::map<std::string, tState> participants;
+        RPCCallScope call(RPCMetrics::getAnyParticipant(), "automation_interface", "GetAvailableParticipants");
+        if (isFailed(ai.GetAvailableParticipants(participants, timeout_ms)))
+        {
+            call.setFailed();
+        }
+        return participants;
+    }
+
+    std::vector<std::string> getParticipantNames(const std::map<std::string, tState>& participants)
+    {
+        std::vector<std::string> participant_names;
+        participant_names.reserve(participants.size());
+        for (const auto& participant : participants)
+        {
+            participant_names.push_back(participant.first);
+        }
+        return participant_names;
+    }
+
+    bool isDiscoveryComplete(const std::map<std::string, tState>& discovered, const DiscoveryOptions& options)
+    {
+        if (options.expected_count > 0 && discovered.size() >= options.expected_count)
+        {
+            return true;
+        }
+        if (!options.expected_participants.empty())
+        {
+            return std::all_of(options.expected_participants.begin(), options.expected_participants.end(),
+                [&](const std::string& participant)
+                {
+                    return discovered.count(participant) > 0;
+                });
+        }
+        return false;
+    }
+
+    /**
+     * Repeats discovery requests of options.poll_interval_ms and collects the replies
+     * until a condition of @p options is satisfied or options.timeout_ms elapsed.
+     * The latest replied state is kept per participant.
+     */
+    std::map<std::string, tState> discoverParticipants(AutomationInterface& ai, const DiscoveryOptions& options)
+    {
+        if (options.expected_count == 0 && options.expected_participants.empty() && options.quiet_period_ms <= 0)
+        {
+            return requestAvailableParticipants(ai, options.timeout_ms);
+        }
+        const timestamp_t begin = a_util::system::getCurrentMilliseconds();
+        const timestamp_t until = begin + options.timeout_ms;
+        const timestamp_t poll_interval = std::max<timestamp_t>(options.poll_interval_ms, 1);
+        timestamp_t last_appearance = begin;
+        std::map<std::string, tState> discovered;
+        for (timestamp_t now = begin; now < until; now = a_util::system::getCurrentMilliseconds())
+        {
+            bool appeared = false;
+            for (const auto& participant : requestAvailableParticipants(ai, std::min(poll_interval, until - now)))
+            {
+                appeared = discovered.count(participant.first) == 0 || appeared;
+                discovered[participant.first] = participant.second;
+            }
+            now = a_util::system::getCurrentMilliseconds();
+            if (appeared)
+            {
+                last_appearance = now;
+            }
+            if (isDiscoveryComplete(discovered, options)
+                || (options.quiet_period_ms > 0 && now - last_appearance >= options.quiet_period_ms))
+            {
+                break;
+            }
+        }
+        return discovered;
+    }
+
+    /**
+     * Requests the system names of the participants concurrently and keeps the participants of system @p name.
+     * Only the participant info is connected, participants without system affiliation (before FEP 3) are kept.
+     */
+    std::vector<std::string> filterBySystemName(AutomationInterface& ai,
+        const std::string& name,
+        const std::vector<std::string>& participants)
+    {
+        const auto affiliated = runForEachParticipant<bool>(participants,
+            [&ai, &name](const std::string& participant_name)
+            {
+                double version = 0.0;
+                {
+                    RPCCallScope call(participant_name, "automation_interface", "GetParticipantFEPVersion");
+                    if (isFailed(ai.GetParticipantFEPVersion(version, participant_name)))
+                    {
+                        call.setFailed();
+                        return false;
+                    }
+                }
+                if (std::isless(version, 3.0))
+                {
+                    return true;
+                }
+                try
+                {
+                    ParticipantInfoProxy<fep::rpc::IRPCParticipantInfo> info(participant_name,
+                        fep::rpc::IRPCParticipantInfo::getRPCIID(),
+                        ai.getInternalRPC());
+                    return info.getSystemName() == name;
+                }
+                catch (...)
+                {
+                    return false;
+                }
+            });
+
+        std::vector<std::string> system_participants;
+        std::copy_if(participants.begin(), participants.end(), std::back_inserter(system_participants),
+            [&affiliated](const std::string& participant_name)
+            {
+                return affiliated.at(participant_name);
+            });
+        return system_participants;
+    }
+
+    /**
+     * Adds the participants concurrently and reads their metadata in the same pass,
+     * the values stay cached on the proxies of the system. Standalone participants are removed again.
+     */
+    System createDiscoveredSystem(const std::string& name,
+        const std::map<std::string, tState>& participants,
+        std::vector<DiscoveredParticipant>& discovered_participants)
+    {
+        System discovered_sys(name);
+        auto metadata = runForEachParticipant<DiscoveredParticipant>(getParticipantNames(participants),
+            [&discovered_sys](const std::string& participant_name)
+            {
+                discovered_sys.add(participant_name);
+                return discovered_sys.getParticipant(participant_name).getMetadata();
+            });
+
+        discovered_participants.clear();
+        for (auto& participant : metadata)
+        {
+            if (participant.second.standalone)
+            {
+                discovered_sys.remove(participant.first);
+            }
+            else
+            {
+                participant.second.state = participants.at(participant.first);
+                discovered_participants.push_back(std::move(participant.second));
+            }
+        }
+        return discovered_sys;
+    }
+
     System discoverSystemOnDDS(std::string name,
         AutomationInterface& ai,
         timestamp_t timeout_ms /*= FEP_SYSTEM_DISCOVER_TIME_MS*/)
     {
-         
-        std::vector<std::string> participants;
-        ai.GetAvailableParticipants(participants, timeout_ms);
-
+        TraceScope trace("system", "discover", name);
+        // no metadata is read here, only the standalone flag, the values stay cached on the proxies
         System discovered_sys(name);
-        discovered_sys.add(participants);
+        const auto standalone = runForEachParticipant<bool>(
+            getParticipantNames(requestAvailableParticipants(ai, timeout_ms)),
+            [&discovered_sys](const std::string& participant_name)
+            {
+                discovered_sys.add(participant_name);
+                return discovered_sys.getParticipant(participant_name).isStandalone();
+            });
+        for (const auto& participant : standalone)
+        {
+            if (participant.second)
+            {
+                discovered_sys.remove(participant.first);
+            }
+        }
+        return discovered_sys;
+    }
 
-        const auto standalone_participant_names = getStandaloneParticipants(discovered_sys.getParticipants());
-        if (standalone_participant_names.size() > 0)
+    System discoverSystemOnDDS(std::string name,
+        AutomationInterface& ai,
+        const DiscoveryOptions& options,
+        std::vector<DiscoveredParticipant>& discovered_participants)
+    {
+        TraceScope trace("system", "discover", name);
+        auto participants = discoverParticipants(ai, options);
+        if (options.filter_by_system_name)
         {
-            std::for_each
-                (standalone_participant_names.begin()
-                , standalone_participant_names.end()
-                , [&](const std::string& name)
-                    {
-                        discovered_sys.remove(name);
-                    }
-                );
+            std::map<std::string, tState> system_participants;
+            for (const auto& participant_name : filterBySystemName(ai, name, getParticipantNames(participants)))
+            {
+                system_participants[participant_name] = participants.at(participant_name);
+            }
+            participants.swap(system_participants);
         }
-   
-        return std::move(discovered_sys);
+        return createDiscoveredSystem(name, participants, discovered_participants);
     }
 
     System discoverSystemOnDDS(std::string name,
@@ -807,4 +1482,65 @@ namespace fep
         ConnectionInterface conn;
         return std::move(discoverSystemOnDDS(name, conn.getAI(), timeout_ms));
     }
+
+    System discoverSystemOnDDS(std::string name,
+        uint16_t dds_domain_id,
+        const DiscoveryOptions& options)
+    {
+        std::vector<DiscoveredParticipant> discovered_participants;
+        return discoverSystemOnDDS(name, dds_domain_id, options, discovered_participants);
+    }
+
+    fep::System discoverSystem(std::string name, const DiscoveryOptions& options)
+    {
+        std::vector<DiscoveredParticipant> discovered_participants;
+        return discoverSystem(name, options, discovered_participants);
+    }
+
+    System discoverSystemOnDDS(std::string name,
+        uint16_t dds_domain_id,
+        const DiscoveryOptions& options,
+        std::vector<DiscoveredParticipant>& discovered_participants)
+    {
+        ConnectionInterface conn;
+        return discoverSystemOnDDS(name, conn.getAI(dds_domain_id), options, discovered_participants);
+    }
+
+    fep::System discoverSystem(std::string name,
+        const DiscoveryOptions& options,
+        std::vector<DiscoveredParticipant>& discovered_participants)
+    {
+        ConnectionInterface conn;
+        return discoverSystemOnDDS(name, conn.getAI(), options, discovered_participants);
+    }
+
+    void setRPCMetricsEnabled(bool enabled)
+    {
+        RPCMetrics::get().setEnabled(enabled);
+    }
+
+    std::vector<RPCCallMetrics> getRPCMetrics()
+    {
+        return RPCMetrics::get().getMetrics();
+    }
+
+    void resetRPCMetrics()
+    {
+        RPCMetrics::get().reset();
+    }
+
+    void setTracingEnabled(bool enabled)
+    {
+        TraceRecorder::get().setEnabled(enabled);
+    }
+
+    void writeTrace(const std::string& file_path)
+    {
+        TraceRecorder::get().write(file_path);
+    }
+
+    void clearTrace()
+    {
+        TraceRecorder::get().clear();
+    }
 }
\ No newline at end of file
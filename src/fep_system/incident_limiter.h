@@ -0,0 +1,282 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <functional>
+
+#include "fep_system/fep_system.h"
+
+namespace fep
+{
+    /**
+     * @brief Limits the incidents passed on to the monitors per source and incident code by a token bucket.
+     *
+     * Every (source, incident code) may pass IncidentRateLimit::burst incidents at once,
+     * the bucket refills by IncidentRateLimit::rate incidents per second.
+     * The incidents over the limit are counted and coalesced to one summary per key,
+     * the summary is due IncidentRateLimit::summary_interval_ms after the first suppressed incident.
+     * Due summaries are collected by the next incident of any key or by collectDueSummaries,
+     * which is called periodically, so the summary of a storm is not held back after it ended.
+     * The settings and the due time are atomics, the buckets are locked by stripe,
+     * so incidents of different sources rarely share a lock and a disabled limit takes none.
+     */
+    class IncidentLimiter
+    {
+    public:
+        /// the count of keys kept before the keys without suppressed incidents are forgotten
+        static const size_t max_keys = 4096;
+        /// the keys are distributed by hash to this count of independently locked stripes
+        static const size_t stripe_count = 16;
+
+        /// the coalesced incidents of one key
+        struct Summary
+        {
+            std::string source;
+            int16_t incident;
+            logging::Severity severity;
+            timestamp_t simulation_time;
+            size_t count;
+            /// (ms) from the first to the last coalesced incident
+            int64_t duration_ms;
+        };
+
+        explicit IncidentLimiter(const IncidentRateLimit& limit = IncidentRateLimit())
+        {
+            setLimit(limit);
+        }
+
+        void setLimit(const IncidentRateLimit& limit)
+        {
+            _rate.store(limit.rate);
+            _burst.store(std::max<size_t>(limit.burst, 1));
+            _interval_ns.store(std::max<int64_t>(limit.summary_interval_ms, 0) * 1000000);
+            _enabled.store(limit.rate > 0.0);
+            if (limit.rate <= 0.0)
+            {
+                // nothing is limited anymore, the pending summaries are collected by the next call
+                _next_due_ns.store(0);
+            }
+        }
+
+        /**
+         * @brief takes a token for the incident, only the stripe of the key is locked and only if the limit is enabled
+         *
+         * @param summaries receives the summaries due now, the summary of this key before the incident
+         * @return true if the incident is passed on
+         */
+        bool admit(const char* source,
+                   int16_t incident,
+                   logging::Severity severity,
+                   timestamp_t simulation_time,
+                   std::vector<Summary>& summaries)
+        {
+            const int64_t now = steadyNanoseconds();
+            if (now >= _next_due_ns.load(std::memory_order_relaxed))
+            {
+                collectDue(now, summaries);
+            }
+            if (!_enabled.load(std::memory_order_relaxed))
+            {
+                return true;
+            }
+
+            // the key buffer of the thread, so looking up known keys does not allocate
+            static thread_local std::string key;
+            key.assign(source ? source : "");
+            key.append(reinterpret_cast<const char*>(&incident), sizeof(incident));
+
+            Stripe& stripe = _stripes[std::hash<std::string>()(key) % stripe_count];
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            auto current = stripe.buckets.find(key);
+            if (current == stripe.buckets.end())
+            {
+                if (stripe.buckets.size() >= max_keys / stripe_count)
+                {
+                    forgetIdleKeys(stripe);
+                }
+                current = stripe.buckets.emplace(key, Bucket()).first;
+                current->second.tokens = static_cast<double>(_burst.load(std::memory_order_relaxed));
+                current->second.last_refill_ns = now;
+            }
+            Bucket& bucket = current->second;
+            refill(bucket, now);
+
+            if (bucket.tokens >= 1.0)
+            {
+                bucket.tokens -= 1.0;
+                if (bucket.suppressed > 0)
+                {
+                    summaries.push_back(createSummary(current->first, bucket));
+                }
+                return true;
+            }
+
+            if (bucket.suppressed == 0)
+            {
+                bucket.first_suppressed_ns = now;
+                bucket.severity = severity;
+                lowerNextDue(now + _interval_ns.load(std::memory_order_relaxed));
+            }
+            else if (severity != logging::SEVERITY_OFF && severity < bucket.severity)
+            {
+                // the summary has the most severe level of the coalesced incidents
+                bucket.severity = severity;
+            }
+            ++bucket.suppressed;
+            bucket.last_suppressed_ns = now;
+            bucket.simulation_time = simulation_time;
+            return false;
+        }
+
+        /**
+         * @brief collects the summaries due now, only takes the time if nothing is due
+         */
+        void collectDueSummaries(std::vector<Summary>& summaries)
+        {
+            const int64_t now = steadyNanoseconds();
+            if (now >= _next_due_ns.load(std::memory_order_relaxed))
+            {
+                collectDue(now, summaries);
+            }
+        }
+
+        /**
+         * @brief collects the summaries of all keys with suppressed incidents, due or not
+         */
+        void collectSummaries(std::vector<Summary>& summaries)
+        {
+            collectDue(std::numeric_limits<int64_t>::max(), summaries);
+        }
+
+    private:
+        struct Bucket
+        {
+            double tokens = 0.0;
+            int64_t last_refill_ns = 0;
+            size_t suppressed = 0;
+            int64_t first_suppressed_ns = 0;
+            int64_t last_suppressed_ns = 0;
+            logging::Severity severity = logging::SEVERITY_OFF;
+            timestamp_t simulation_time = -1;
+        };
+
+        struct Stripe
+        {
+            std::mutex mutex;
+            std::unordered_map<std::string, Bucket> buckets;
+        };
+
+        static int64_t steadyNanoseconds()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        void refill(Bucket& bucket, int64_t now) const
+        {
+            const double elapsed_s = static_cast<double>(now - bucket.last_refill_ns) / 1e9;
+            bucket.tokens = std::min(static_cast<double>(_burst.load(std::memory_order_relaxed)),
+                bucket.tokens + elapsed_s * _rate.load(std::memory_order_relaxed));
+            bucket.last_refill_ns = now;
+        }
+
+        void lowerNextDue(int64_t due_ns)
+        {
+            int64_t next_due_ns = _next_due_ns.load(std::memory_order_relaxed);
+            while (due_ns < next_due_ns
+                && !_next_due_ns.compare_exchange_weak(next_due_ns, due_ns, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        static Summary createSummary(const std::string& key, Bucket& bucket)
+        {
+            Summary summary;
+            const size_t source_size = key.size() - sizeof(int16_t);
+            summary.source = key.substr(0, source_size);
+            std::copy(key.data() + source_size, key.data() + key.size(), reinterpret_cast<char*>(&summary.incident));
+            summary.severity = bucket.severity;
+            summary.simulation_time = bucket.simulation_time;
+            summary.count = bucket.suppressed;
+            summary.duration_ms = (bucket.last_suppressed_ns - bucket.first_suppressed_ns) / 1000000;
+            bucket.suppressed = 0;
+            return summary;
+        }
+
+        /// collects the summaries due at @p now and schedules the next check, locks one stripe at a time
+        void collectDue(int64_t now, std::vector<Summary>& summaries)
+        {
+            const bool enabled = _enabled.load();
+            const int64_t interval = _interval_ns.load();
+            // reset before the scan, suppressions in stripes scanned already lower it again
+            _next_due_ns.store(std::numeric_limits<int64_t>::max());
+            for (auto& stripe : _stripes)
+            {
+                std::lock_guard<std::mutex> lock(stripe.mutex);
+                for (auto& current : stripe.buckets)
+                {
+                    Bucket& bucket = current.second;
+                    if (bucket.suppressed == 0)
+                    {
+                        continue;
+                    }
+                    if (!enabled || now - bucket.first_suppressed_ns >= interval)
+                    {
+                        summaries.push_back(createSummary(current.first, bucket));
+                    }
+                    else
+                    {
+                        lowerNextDue(bucket.first_suppressed_ns + interval);
+                    }
+                }
+            }
+        }
+
+        static void forgetIdleKeys(Stripe& stripe)
+        {
+            for (auto current = stripe.buckets.begin(); current != stripe.buckets.end();)
+            {
+                if (current->second.suppressed == 0)
+                {
+                    current = stripe.buckets.erase(current);
+                }
+                else
+                {
+                    ++current;
+                }
+            }
+        }
+
+        std::atomic<bool> _enabled{ false };
+        std::atomic<double> _rate{ 0.0 };
+        std::atomic<size_t> _burst{ 1 };
+        std::atomic<int64_t> _interval_ns{ 0 };
+        std::atomic<int64_t> _next_due_ns{ std::numeric_limits<int64_t>::max() };
+        std::array<Stripe, stripe_count> _stripes;
+    };
+}
@@ -0,0 +1,107 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "fep_system/fep_system.h"
+#include "a_util/datetime.h"
+
+namespace fep
+{
+    /**
+     * @brief Local wall clock time for log records without a calendar conversion per record.
+     *
+     * The time is taken from the monotonic high resolution clock plus the offset to the local wall clock.
+     * The offset is taken by a_util::datetime::getCurrentLocalDateTime once per refresh_interval,
+     * so changes of the wall clock (i.e. by time synchronization) are followed within that interval.
+     */
+    class LogClock
+    {
+    public:
+        static constexpr int64_t refresh_interval_ns = 1000000000;
+
+        static LogClock& get()
+        {
+            static LogClock clock;
+            return clock;
+        }
+
+        /**
+         * @brief the current local time as given by a_util::datetime::DateTime::toTimestamp (microseconds)
+         */
+        timestamp_t nowMicroseconds()
+        {
+            return nowNanoseconds() / 1000;
+        }
+
+        /**
+         * @brief the current local time in nanoseconds
+         */
+        timestamp_t nowNanoseconds()
+        {
+            const int64_t steady = steadyNanoseconds();
+            if (steady - _last_refresh.load(std::memory_order_relaxed) >= refresh_interval_ns)
+            {
+                refresh(steady);
+            }
+            return steady + _offset.load(std::memory_order_relaxed);
+        }
+
+        timestamp_t now(MonitorTimeResolution resolution)
+        {
+            return resolution == MonitorTimeResolution::nanoseconds ? nowNanoseconds() : nowMicroseconds();
+        }
+
+    private:
+        LogClock()
+        {
+            const int64_t steady = steadyNanoseconds();
+            _last_refresh.store(steady);
+            _offset.store(readOffset());
+        }
+
+        static int64_t steadyNanoseconds()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        static int64_t readOffset()
+        {
+            const int64_t wall = a_util::datetime::getCurrentLocalDateTime().toTimestamp() * 1000;
+            return wall - steadyNanoseconds();
+        }
+
+        void refresh(int64_t steady)
+        {
+            int64_t last_refresh = _last_refresh.load(std::memory_order_relaxed);
+            // only one thread reads the wall clock per interval, the others keep the current offset
+            if (steady - last_refresh >= refresh_interval_ns
+                && _last_refresh.compare_exchange_strong(last_refresh, steady, std::memory_order_relaxed))
+            {
+                _offset.store(readOffset(), std::memory_order_relaxed);
+            }
+        }
+
+        std::atomic<int64_t> _last_refresh{ 0 };
+        std::atomic<int64_t> _offset{ 0 };
+    };
+}
@@ -0,0 +1,300 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+#include "fep_system/fep_system.h"
+
+namespace fep
+{
+    /**
+     * @brief one event for the IEventMonitor as delivered from the LogRing, the time is taken when the event is queued.
+     * The participant name is the new name and the message the old name on name changes.
+     */
+    struct MonitorEvent : public MonitorLogRecord
+    {
+        enum class Type
+        {
+            log,
+            state_changed,
+            name_changed,
+            participant_added,
+            participant_removed
+        };
+
+        Type type = Type::log;
+        tState state = FS_UNKNOWN;
+    };
+
+    /**
+     * @brief a not owned piece of text, copied into the LogRing without creating a std::string
+     */
+    struct LogText
+    {
+        LogText(const std::string& text) : data(text.data()), size(text.size())
+        {
+        }
+        LogText(const char* text) : data(text ? text : ""), size(text ? strlen(text) : 0)
+        {
+        }
+        LogText(const char* text, size_t text_size) : data(text), size(text_size)
+        {
+        }
+
+        const char* data;
+        size_t size;
+    };
+
+    /**
+     * @brief Bounded lock-free queue of preallocated monitor events for many producers and one consumer.
+     *
+     * Every slot holds a fixed size text buffer, so queueing an event with texts up to text_capacity
+     * (participant name, logger name and message together) takes no lock and allocates nothing.
+     * Longer texts are stored in a std::string of the slot.
+     * The slots are sequenced as in the bounded queue by D. Vyukov: a slot is claimed by a CAS on the position
+     * and published by its sequence number. Taking events uses a CAS too, so a producer may drop the oldest event.
+     */
+    class LogRing
+    {
+    public:
+        static const size_t text_capacity = 512;
+
+        /**
+         * @brief preallocates the slots, the count of slots is @p capacity rounded up to a power of two
+         */
+        explicit LogRing(size_t capacity) : _slots(roundUpToPowerOfTwo(capacity)), _mask(_slots.size() - 1)
+        {
+            for (size_t idx = 0; idx < _slots.size(); ++idx)
+            {
+                _slots[idx].sequence.store(idx, std::memory_order_relaxed);
+            }
+            setLimit(capacity);
+        }
+        LogRing(const LogRing&) = delete;
+        LogRing& operator=(const LogRing&) = delete;
+
+        /**
+         * @brief limits the count of queued events to @p limit (at least 1, at most the count of slots)
+         */
+        void setLimit(size_t limit)
+        {
+            _limit.store(std::min(std::max<size_t>(limit, 1), _slots.size()), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief queues an event
+         *
+         * @return false if the ring is full
+         */
+        bool tryPush(MonitorEvent::Type type,
+                     timestamp_t time,
+                     timestamp_t simulation_time,
+                     logging::Category category,
+                     logging::Severity severity,
+                     tState state,
+                     LogText participant_name,
+                     LogText logger_name,
+                     LogText message)
+        {
+            size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+            while (true)
+            {
+                Slot& slot = _slots[pos & _mask];
+                const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+                if (difference == 0)
+                {
+                    if (pos - _dequeue_pos.load(std::memory_order_relaxed) >= _limit.load(std::memory_order_relaxed))
+                    {
+                        return false;
+                    }
+                    if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        slot.record.write(type, time, simulation_time, category, severity, state, participant_name, logger_name, message);
+                        slot.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = _enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief takes the oldest event
+         *
+         * @param event receives the event, nullptr to drop it
+         * @return false if there is no (completely queued) event
+         */
+        bool tryPop(MonitorEvent* event)
+        {
+            size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+            while (true)
+            {
+                Slot& slot = _slots[pos & _mask];
+                const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+                if (difference == 0)
+                {
+                    if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        if (event)
+                        {
+                            slot.record.read(*event);
+                        }
+                        slot.sequence.store(pos + _mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = _dequeue_pos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief count of the events claimed a slot so far (including the dropped ones)
+         */
+        size_t getPushCount() const
+        {
+            return _enqueue_pos.load();
+        }
+
+        /**
+         * @brief count of the events taken so far (including the dropped ones)
+         */
+        size_t getPopCount() const
+        {
+            return _dequeue_pos.load();
+        }
+
+        /**
+         * @brief true if no event is queued (completely)
+         */
+        bool isEmpty() const
+        {
+            const size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+            return _slots[pos & _mask].sequence.load(std::memory_order_acquire) != pos + 1;
+        }
+
+    private:
+        struct Record
+        {
+            void write(MonitorEvent::Type event_type,
+                       timestamp_t event_time,
+                       timestamp_t event_simulation_time,
+                       logging::Category event_category,
+                       logging::Severity event_severity,
+                       tState event_state,
+                       const LogText& participant_name,
+                       const LogText& logger_name,
+                       const LogText& message)
+            {
+                type = event_type;
+                time = event_time;
+                simulation_time = event_simulation_time;
+                category = event_category;
+                severity = event_severity;
+                state = event_state;
+                participant_name_size = participant_name.size;
+                logger_name_size = logger_name.size;
+                message_size = message.size;
+                const size_t size = participant_name.size + logger_name.size + message.size;
+                char* target = text;
+                if (size > text_capacity)
+                {
+                    long_text.resize(size);
+                    target = &long_text[0];
+                }
+                memcpy(target, participant_name.data, participant_name.size);
+                memcpy(target + participant_name.size, logger_name.data, logger_name.size);
+                memcpy(target + participant_name.size + logger_name.size, message.data, message.size);
+            }
+
+            void read(MonitorEvent& event) const
+            {
+                event.type = type;
+                event.log_time = time;
+                event.simulation_time = simulation_time;
+                event.category = category;
+                event.severity_level = severity;
+                event.state = state;
+                const size_t size = participant_name_size + logger_name_size + message_size;
+                const char* source = size > text_capacity ? long_text.data() : text;
+                event.participant_name.assign(source, participant_name_size);
+                event.logger_name.assign(source + participant_name_size, logger_name_size);
+                event.message.assign(source + participant_name_size + logger_name_size, message_size);
+            }
+
+            MonitorEvent::Type type = MonitorEvent::Type::log;
+            timestamp_t time = 0;
+            timestamp_t simulation_time = -1;
+            logging::Category category = logging::CATEGORY_SYSTEM;
+            logging::Severity severity = logging::SEVERITY_INFO;
+            tState state = FS_UNKNOWN;
+            size_t participant_name_size = 0;
+            size_t logger_name_size = 0;
+            size_t message_size = 0;
+            char text[text_capacity];
+            std::string long_text;
+        };
+
+        struct Slot
+        {
+            std::atomic<size_t> sequence{ 0 };
+            Record record;
+        };
+
+        static size_t roundUpToPowerOfTwo(size_t value)
+        {
+            size_t result = 1;
+            while (result < value)
+            {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        std::vector<Slot> _slots;
+        const size_t _mask;
+        std::atomic<size_t> _limit{ 1 };
+        // the positions are written by different threads, keep them on different cache lines
+        char _padding_enqueue[64];
+        std::atomic<size_t> _enqueue_pos{ 0 };
+        char _padding_dequeue[64];
+        std::atomic<size_t> _dequeue_pos{ 0 };
+        char _padding_end[64];
+    };
+}
@@ -0,0 +1,289 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <set>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+
+#include "fep_participant_sdk.h"
+#include "fep_system/fep_system.h"
+
+namespace fep
+{
+    /**
+     * @brief Keeps the participants of a system current in a background thread.
+     *
+     * Every interval one discovery round adds the new participants, participants which did not reply
+     * to MembershipTrackingOptions::missed_rounds consecutive rounds are removed.
+     * The state and name changes received from the automation interface are handled with the next round
+     * or right away: a participant in FS_SHUTDOWN is removed, a participant in FS_STARTUP is refreshed
+     * (it restarted) and a renamed participant is replaced by its new name.
+     * All calls to the participants are made from the tracker thread, never from the callbacks.
+     */
+    class MembershipTracker : public IAutomationParticipantMonitor
+    {
+    public:
+        /**
+         * @brief The tracked system
+         */
+        class IMembers
+        {
+        public:
+            virtual ~IMembers() = default;
+            virtual std::vector<std::string> getMemberNames() const = 0;
+            /// the participants replying to one discovery request
+            virtual std::vector<std::string> discoverMembers(const MembershipTrackingOptions& options) = 0;
+            /// creates and warms up the proxy, false if the participant may not be part of the system
+            virtual bool addMember(const std::string& participant_name, const MembershipTrackingOptions& options) = 0;
+            virtual void removeMember(const std::string& participant_name) = 0;
+            /// reconnects the restarted participant and reads its cached values again,
+            /// false if it may not be part of the system anymore
+            virtual bool refreshMember(const std::string& participant_name) = 0;
+            virtual void notifyMembership(const std::string& participant_name, bool added) = 0;
+        };
+
+        MembershipTracker(IMembers& members, AutomationInterface& ai, const MembershipTrackingOptions& options) :
+            _members(members), _ai(ai), _options(options)
+        {
+            _options.missed_rounds = std::max<size_t>(_options.missed_rounds, 1);
+            if (isFailed(_ai.RegisterMonitoring("*", this)))
+            {
+                throw std::runtime_error{ "The membership tracking can not receive the state changes of the participants" };
+            }
+            _thread = std::thread([this]() { run(); });
+        }
+
+        ~MembershipTracker()
+        {
+            _ai.UnregisterMonitoring(this);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopped = true;
+            }
+            _wakeup.notify_all();
+            _thread.join();
+        }
+
+        MembershipTracker(const MembershipTracker&) = delete;
+        MembershipTracker& operator=(const MembershipTracker&) = delete;
+
+        void OnStateChanged(const std::string& sender, tState state) override
+        {
+            if (state != FS_SHUTDOWN && state != FS_STARTUP)
+            {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _changes.push_back(Change{ state == FS_SHUTDOWN ? Change::Type::shutdown : Change::Type::startup,
+                    sender, std::string() });
+            }
+            _wakeup.notify_all();
+        }
+
+        void OnNameChanged(const std::string& sender, const std::string& old_name) override
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _changes.push_back(Change{ Change::Type::renamed, sender, old_name });
+            }
+            _wakeup.notify_all();
+        }
+
+    private:
+        struct Change
+        {
+            enum class Type
+            {
+                startup,
+                shutdown,
+                renamed
+            };
+            Type type;
+            std::string participant_name;
+            std::string old_name;
+        };
+
+        void run()
+        {
+            auto next_round = std::chrono::steady_clock::now();
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (!_stopped)
+            {
+                if (_changes.empty() && std::chrono::steady_clock::now() < next_round)
+                {
+                    _wakeup.wait_until(lock, next_round, [this]() { return _stopped || !_changes.empty(); });
+                    continue;
+                }
+                std::deque<Change> changes;
+                changes.swap(_changes);
+                lock.unlock();
+                handleChanges(changes);
+                if (std::chrono::steady_clock::now() >= next_round)
+                {
+                    discoverRound();
+                    next_round = std::chrono::steady_clock::now() + std::chrono::milliseconds(_options.interval_ms);
+                }
+                lock.lock();
+            }
+        }
+
+        void handleChanges(const std::deque<Change>& changes)
+        {
+            for (const auto& change : changes)
+            {
+                const auto members = getMembers();
+                switch (change.type)
+                {
+                case Change::Type::shutdown:
+                    if (members.count(change.participant_name) > 0)
+                    {
+                        remove(change.participant_name);
+                    }
+                    break;
+                case Change::Type::startup:
+                    _rejected.erase(change.participant_name);
+                    if (members.count(change.participant_name) > 0)
+                    {
+                        refresh(change.participant_name);
+                    }
+                    else
+                    {
+                        add(change.participant_name);
+                    }
+                    break;
+                case Change::Type::renamed:
+                    _rejected.erase(change.old_name);
+                    if (members.count(change.old_name) > 0)
+                    {
+                        remove(change.old_name);
+                        add(change.participant_name);
+                    }
+                    break;
+                }
+            }
+        }
+
+        void discoverRound()
+        {
+            std::vector<std::string> discovered;
+            if (!tryCall([&]() { discovered = _members.discoverMembers(_options); }))
+            {
+                return;
+            }
+            const std::set<std::string> replied(discovered.begin(), discovered.end());
+            for (const auto& participant_name : getMembers())
+            {
+                if (replied.count(participant_name) > 0)
+                {
+                    _missed.erase(participant_name);
+                }
+                else if (++_missed[participant_name] >= _options.missed_rounds)
+                {
+                    remove(participant_name);
+                }
+            }
+            for (const auto& participant_name : discovered)
+            {
+                add(participant_name);
+            }
+        }
+
+        void add(const std::string& participant_name)
+        {
+            if (getMembers().count(participant_name) > 0 || _rejected.count(participant_name) > 0)
+            {
+                return;
+            }
+            bool added = false;
+            if (!tryCall([&]() { added = _members.addMember(participant_name, _options); }))
+            {
+                //not reachable, tried again with the next round it replies to
+                return;
+            }
+            if (added)
+            {
+                _missed.erase(participant_name);
+                _members.notifyMembership(participant_name, true);
+            }
+            else
+            {
+                _rejected.insert(participant_name);
+            }
+        }
+
+        void refresh(const std::string& participant_name)
+        {
+            bool member = true;
+            if (tryCall([&]() { member = _members.refreshMember(participant_name); }) && !member)
+            {
+                remove(participant_name);
+                _rejected.insert(participant_name);
+            }
+        }
+
+        void remove(const std::string& participant_name)
+        {
+            _members.removeMember(participant_name);
+            _missed.erase(participant_name);
+            _members.notifyMembership(participant_name, false);
+        }
+
+        std::set<std::string> getMembers() const
+        {
+            const auto names = _members.getMemberNames();
+            return std::set<std::string>(names.begin(), names.end());
+        }
+
+        template<typename Call>
+        static bool tryCall(Call call)
+        {
+            try
+            {
+                call();
+                return true;
+            }
+            catch (...)
+            {
+                return false;
+            }
+        }
+
+        IMembers& _members;
+        AutomationInterface& _ai;
+        MembershipTrackingOptions _options;
+        /// count of consecutive rounds the members did not reply to
+        std::map<std::string, size_t> _missed;
+        /// participants which may not be part of the system (standalone or foreign), until they restart
+        std::set<std::string> _rejected;
+        std::mutex _mutex;
+        std::condition_variable _wakeup;
+        std::deque<Change> _changes;
+        bool _stopped = false;
+        std::thread _thread;
+    };
+}
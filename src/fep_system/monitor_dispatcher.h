@@ -0,0 +1,775 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+
+#include "fep_system/fep_system.h"
+#include "a_util/strings.h"
+#include "log_ring.h"
+#include "log_clock.h"
+
+namespace fep
+{
+    /**
+     * @brief a log of @p severity is enabled by the severity level @p level (and more verbose levels)
+     */
+    inline bool isSeverityEnabled(logging::Severity severity, logging::Severity level)
+    {
+        return severity != logging::SEVERITY_OFF && severity <= level;
+    }
+
+    /**
+     * @brief Delivers the events to one IEventMonitor from a dedicated delivery thread.
+     *
+     * The events are shared between all deliveries, they are queued by pointer.
+     * The queue is bounded, full queues are handled by a MonitorOverflowPolicy.
+     * The dropped events are counted and reported to the monitor by a warning before the next event.
+     * The events are taken in batches as given by the MonitorBatchOptions, consecutive logs
+     * and consecutive state changes of a batch are delivered by one call.
+     */
+    class MonitorDelivery
+    {
+    public:
+        MonitorDelivery(IEventMonitor& monitor,
+                        MonitorFilter filter,
+                        MonitorBatchOptions batching,
+                        std::string system_name) :
+            _state(std::make_shared<State>(monitor, std::move(filter), batching, std::move(system_name)))
+        {
+            auto state = _state;
+            _delivery = std::thread([state]() { deliver(*state); });
+        }
+        ~MonitorDelivery()
+        {
+            close();
+        }
+        MonitorDelivery(const MonitorDelivery&) = delete;
+        MonitorDelivery(MonitorDelivery&&) = delete;
+        MonitorDelivery& operator=(const MonitorDelivery&) = delete;
+        MonitorDelivery& operator=(MonitorDelivery&&) = delete;
+
+        /**
+         * @brief delivers the queued events and stops the delivery thread,
+         * the monitor is not called anymore when this function returns (unless called from within the monitor)
+         */
+        void close()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_state->mutex);
+                _state->stop = true;
+            }
+            _state->not_empty.notify_all();
+            _state->not_full.notify_all();
+            std::lock_guard<std::mutex> lock(_close_mutex);
+            if (std::this_thread::get_id() == _delivery.get_id())
+            {
+                //closed from within the monitor, the thread finishes on its own
+                _delivery.detach();
+            }
+            else if (_delivery.joinable())
+            {
+                _delivery.join();
+            }
+        }
+
+        const IEventMonitor& getMonitor() const
+        {
+            return _state->monitor;
+        }
+
+        const MonitorFilter& getFilter() const
+        {
+            return _state->filter;
+        }
+
+        /**
+         * @brief true if the filter selects the event
+         */
+        bool accepts(const MonitorEvent& event) const
+        {
+            if (event.type != MonitorEvent::Type::log)
+            {
+                return true;
+            }
+            const auto& filter = _state->filter;
+            return isSeverityEnabled(event.severity_level, filter.severity_level)
+                && (filter.categories.empty()
+                    || std::find(filter.categories.begin(), filter.categories.end(), event.category) != filter.categories.end());
+        }
+
+        /**
+         * @brief counts events dropped before they reached this delivery
+         */
+        void addDropped(size_t dropped)
+        {
+            std::lock_guard<std::mutex> lock(_state->mutex);
+            _state->dropped += dropped;
+        }
+
+        /**
+         * @brief queues the event, depending on the policy this waits for space in the queue
+         */
+        void push(const std::shared_ptr<const MonitorEvent>& event, size_t capacity, MonitorOverflowPolicy policy)
+        {
+            State& state = *_state;
+            std::unique_lock<std::mutex> lock(state.mutex);
+            if (state.stop)
+            {
+                return;
+            }
+            if (state.events.size() >= capacity)
+            {
+                switch (policy)
+                {
+                case MonitorOverflowPolicy::block:
+                    state.not_full.wait(lock, [&]() { return state.stop || state.events.size() < capacity; });
+                    if (state.stop)
+                    {
+                        return;
+                    }
+                    break;
+                case MonitorOverflowPolicy::drop_newest:
+                    ++state.dropped;
+                    return;
+                default:
+                    state.events.pop_front();
+                    ++state.dropped;
+                    break;
+                }
+            }
+            state.events.push_back(event);
+            lock.unlock();
+            state.not_empty.notify_one();
+        }
+
+        /**
+         * @brief true if the current thread delivers events to a monitor
+         */
+        static bool isDeliveryThread()
+        {
+            return deliveryThreadFlag();
+        }
+
+    private:
+        struct State
+        {
+            State(IEventMonitor& monitor, MonitorFilter filter, MonitorBatchOptions batching, std::string system_name) :
+                monitor(monitor), filter(std::move(filter)), batching(batching), system_name(std::move(system_name))
+            {
+            }
+
+            IEventMonitor& monitor;
+            const MonitorFilter filter;
+            const MonitorBatchOptions batching;
+            const std::string system_name;
+            std::mutex mutex;
+            std::condition_variable not_empty;
+            std::condition_variable not_full;
+            std::deque<std::shared_ptr<const MonitorEvent>> events;
+            size_t dropped = 0;
+            bool stop = false;
+        };
+
+        static bool& deliveryThreadFlag()
+        {
+            static thread_local bool is_delivery_thread = false;
+            return is_delivery_thread;
+        }
+
+        static void deliver(State& state)
+        {
+            deliveryThreadFlag() = true;
+            const size_t max_batch_size = std::max<size_t>(state.batching.max_batch_size, 1);
+            std::vector<std::shared_ptr<const MonitorEvent>> batch;
+            std::unique_lock<std::mutex> lock(state.mutex);
+            while (true)
+            {
+                state.not_empty.wait(lock, [&state]() { return state.stop || !state.events.empty(); });
+                if (state.events.empty())
+                {
+                    //stopped and everything is delivered
+                    return;
+                }
+                if (state.batching.window_ms > 0)
+                {
+                    //collect the events of the window, a full batch or closing ends it early
+                    const auto window_end = std::chrono::steady_clock::now()
+                        + std::chrono::milliseconds(state.batching.window_ms);
+                    state.not_empty.wait_until(lock, window_end,
+                        [&]() { return state.stop || state.events.size() >= max_batch_size; });
+                }
+                const size_t count = std::min(state.events.size(), max_batch_size);
+                batch.assign(std::make_move_iterator(state.events.begin()),
+                             std::make_move_iterator(state.events.begin() + count));
+                state.events.erase(state.events.begin(), state.events.begin() + count);
+                const size_t dropped = state.dropped;
+                state.dropped = 0;
+                lock.unlock();
+                state.not_full.notify_all();
+
+                deliverBatch(state, batch, dropped);
+                batch.clear();
+                lock.lock();
+            }
+        }
+
+        /**
+         * @brief calls the monitor once per run of logs and once per run of state changes,
+         * the order of the events is kept
+         */
+        static void deliverBatch(State& state, const std::vector<std::shared_ptr<const MonitorEvent>>& batch, size_t dropped)
+        {
+            std::vector<std::shared_ptr<const MonitorLogRecord>> logs;
+            std::vector<MonitorStateRecord> states;
+            if (dropped > 0)
+            {
+                logs.push_back(createDroppedReport(state, dropped, batch.front()->log_time));
+            }
+            for (const auto& event : batch)
+            {
+                switch (event->type)
+                {
+                case MonitorEvent::Type::state_changed:
+                    callLogs(state.monitor, logs);
+                    states.push_back(MonitorStateRecord{ event->participant_name, event->state });
+                    break;
+                case MonitorEvent::Type::name_changed:
+                case MonitorEvent::Type::participant_added:
+                case MonitorEvent::Type::participant_removed:
+                    callLogs(state.monitor, logs);
+                    callStates(state.monitor, states);
+                    callMembershipChanged(state.monitor, *event);
+                    break;
+                default:
+                    callStates(state.monitor, states);
+                    logs.push_back(event);
+                    break;
+                }
+            }
+            callLogs(state.monitor, logs);
+            callStates(state.monitor, states);
+        }
+
+        static std::shared_ptr<const MonitorLogRecord> createDroppedReport(State& state, size_t dropped, timestamp_t time)
+        {
+            auto report = std::make_shared<MonitorLogRecord>();
+            report->log_time = time;
+            report->severity_level = logging::SEVERITY_WARNING;
+            report->logger_name = state.system_name;
+            report->message = a_util::strings::format(
+                "%d events for the monitor were dropped, the monitoring queue was full",
+                static_cast<int>(dropped));
+            return report;
+        }
+
+        static void callLogs(IEventMonitor& monitor, std::vector<std::shared_ptr<const MonitorLogRecord>>& logs)
+        {
+            if (logs.empty())
+            {
+                return;
+            }
+            try
+            {
+                monitor.onLogBatch(logs);
+            }
+            catch (...)
+            {
+                //there is no one to report to but the monitor itself, keep delivering
+            }
+            logs.clear();
+        }
+
+        static void callStates(IEventMonitor& monitor, std::vector<MonitorStateRecord>& states)
+        {
+            if (states.empty())
+            {
+                return;
+            }
+            try
+            {
+                monitor.onStateChangedBatch(states);
+            }
+            catch (...)
+            {
+                //there is no one to report to but the monitor itself, keep delivering
+            }
+            states.clear();
+        }
+
+        static void callMembershipChanged(IEventMonitor& monitor, const MonitorEvent& event)
+        {
+            try
+            {
+                switch (event.type)
+                {
+                case MonitorEvent::Type::participant_added:
+                    monitor.onParticipantAdded(event.participant_name);
+                    break;
+                case MonitorEvent::Type::participant_removed:
+                    monitor.onParticipantRemoved(event.participant_name);
+                    break;
+                default:
+                    monitor.onNameChanged(event.participant_name, event.message);
+                    break;
+                }
+            }
+            catch (...)
+            {
+                //there is no one to report to but the monitor itself, keep delivering
+            }
+        }
+
+        std::shared_ptr<State> _state;
+        std::mutex _close_mutex;
+        std::thread _delivery;
+    };
+
+    /**
+     * @brief Fans out the events to all registered monitors.
+     *
+     * The events are queued with the time of the LogClock in the order they are pushed into a LogRing, so pushing takes no lock
+     * and allocates nothing for usual texts. The capacity is bounded and a full ring is handled by the MonitorOverflowPolicy.
+     * A router thread takes the events from the ring, copies every event once into a shared immutable MonitorEvent
+     * and queues it to the MonitorDelivery of every monitor whose filter selects it.
+     * The router thread only takes a lock to sleep if there is nothing to route,
+     * the producers only take it to wake the sleeping router thread.
+     */
+    class MonitorDispatcher
+    {
+    public:
+        /// the period of the tick task, also the longest time the idle router sleeps
+        static std::chrono::milliseconds getTickInterval()
+        {
+            return std::chrono::milliseconds(10);
+        }
+
+        MonitorDispatcher(std::string system_name,
+                          size_t capacity,
+                          MonitorOverflowPolicy policy,
+                          MonitorTimeResolution resolution) :
+            _system_name(std::move(system_name)),
+            _ring(capacity),
+            _deliveries(std::make_shared<Deliveries>())
+        {
+            setQueue(capacity, policy);
+            setTimeResolution(resolution);
+            _router = std::thread([this]() { route(); });
+        }
+
+        /**
+         * @brief routes the queued events and delivers them to the monitors still registered
+         */
+        ~MonitorDispatcher()
+        {
+            _stop.store(true);
+            wakeUp();
+            notifySpace();
+            if (_router.joinable())
+            {
+                _router.join();
+            }
+            for (const auto& delivery : *_deliveries)
+            {
+                delivery->close();
+            }
+        }
+        MonitorDispatcher(const MonitorDispatcher&) = delete;
+        MonitorDispatcher(MonitorDispatcher&&) = delete;
+        MonitorDispatcher& operator=(const MonitorDispatcher&) = delete;
+        MonitorDispatcher& operator=(MonitorDispatcher&&) = delete;
+
+        /**
+         * @brief adds a monitor
+         *
+         * @return false if the monitor is already registered
+         */
+        bool addMonitor(IEventMonitor& monitor, const MonitorFilter& filter, const MonitorBatchOptions& batching)
+        {
+            std::lock_guard<std::mutex> lock(_deliveries_mutex);
+            if (find(*_deliveries, monitor) != _deliveries->end())
+            {
+                return false;
+            }
+            auto deliveries = std::make_shared<Deliveries>(*_deliveries);
+            deliveries->push_back(std::make_shared<MonitorDelivery>(monitor, filter, batching, _system_name));
+            _deliveries = deliveries;
+            return true;
+        }
+
+        /**
+         * @brief removes the monitor, the returned delivery has to be closed to deliver the queued events
+         */
+        std::shared_ptr<MonitorDelivery> removeMonitor(const IEventMonitor& monitor)
+        {
+            std::lock_guard<std::mutex> lock(_deliveries_mutex);
+            auto found = find(*_deliveries, monitor);
+            if (found == _deliveries->end())
+            {
+                return {};
+            }
+            auto removed = *found;
+            auto deliveries = std::make_shared<Deliveries>(*_deliveries);
+            deliveries->erase(deliveries->begin() + (found - _deliveries->begin()));
+            _deliveries = deliveries;
+            return removed;
+        }
+
+        /**
+         * @brief removes all monitors, the returned deliveries have to be closed to deliver the queued events
+         */
+        std::vector<std::shared_ptr<MonitorDelivery>> removeAllMonitors()
+        {
+            std::lock_guard<std::mutex> lock(_deliveries_mutex);
+            const auto removed = *_deliveries;
+            _deliveries = std::make_shared<Deliveries>();
+            return removed;
+        }
+
+        bool hasMonitors() const
+        {
+            std::lock_guard<std::mutex> lock(_deliveries_mutex);
+            return !_deliveries->empty();
+        }
+
+        /**
+         * @brief the most verbose severity level any monitor selects, SEVERITY_OFF without monitors
+         */
+        logging::Severity getMaxSeverityLevel() const
+        {
+            std::lock_guard<std::mutex> lock(_deliveries_mutex);
+            logging::Severity level = logging::SEVERITY_OFF;
+            for (const auto& delivery : *_deliveries)
+            {
+                level = std::max(level, delivery->getFilter().severity_level);
+            }
+            return level;
+        }
+
+        /**
+         * @brief waits until all events queued before are routed to the deliveries
+         */
+        void flush() const
+        {
+            const size_t target = _ring.getPushCount();
+            if (_routed.load() >= target)
+            {
+                return;
+            }
+            _flush_waiters.fetch_add(1);
+            {
+                std::unique_lock<std::mutex> lock(_flush_mutex);
+                _flushed.wait(lock, [&]() { return _routed.load() >= target; });
+            }
+            _flush_waiters.fetch_sub(1);
+        }
+
+        /**
+         * @brief changes the capacity and the policy, already queued events are kept.
+         * The slots of the ring are allocated at construction, a larger capacity is limited to them.
+         */
+        void setQueue(size_t capacity, MonitorOverflowPolicy policy)
+        {
+            _ring.setLimit(capacity);
+            _capacity.store(std::max<size_t>(capacity, 1));
+            _policy.store(policy);
+        }
+
+        void setTimeResolution(MonitorTimeResolution resolution)
+        {
+            _resolution.store(resolution);
+        }
+
+        /**
+         * @brief sets the task the router thread runs every tick interval (see getTickInterval), while idle and while routing.
+         * The task may push events, it must not wait for the router.
+         */
+        void setTickTask(std::function<void()> task)
+        {
+            std::lock_guard<std::mutex> lock(_tick_mutex);
+            _tick_task = std::move(task);
+        }
+
+        /**
+         * @brief queues a log with the current time, depending on the policy this waits for space in the queue
+         *
+         * @param simulation_time simulation time of the issuing participant, -1 if not known
+         */
+        void pushLog(timestamp_t simulation_time,
+                     logging::Category category,
+                     logging::Severity severity,
+                     LogText participant_name,
+                     LogText logger_name,
+                     LogText message)
+        {
+            push(MonitorEvent::Type::log, simulation_time, category, severity, FS_UNKNOWN, participant_name, logger_name, message);
+        }
+
+        void pushStateChanged(LogText participant_name, tState state)
+        {
+            push(MonitorEvent::Type::state_changed, -1, logging::CATEGORY_PARTICIPANT, logging::SEVERITY_INFO, state,
+                participant_name, LogText(""), LogText(""));
+        }
+
+        void pushNameChanged(LogText new_name, LogText old_name)
+        {
+            push(MonitorEvent::Type::name_changed, -1, logging::CATEGORY_PARTICIPANT, logging::SEVERITY_INFO, FS_UNKNOWN,
+                new_name, LogText(""), old_name);
+        }
+
+        void pushMembershipChanged(LogText participant_name, bool added)
+        {
+            push(added ? MonitorEvent::Type::participant_added : MonitorEvent::Type::participant_removed,
+                -1, logging::CATEGORY_SYSTEM, logging::SEVERITY_INFO, FS_UNKNOWN,
+                participant_name, LogText(""), LogText(""));
+        }
+
+    private:
+        using Deliveries = std::vector<std::shared_ptr<MonitorDelivery>>;
+
+        static Deliveries::const_iterator find(const Deliveries& deliveries, const IEventMonitor& monitor)
+        {
+            return std::find_if(deliveries.begin(), deliveries.end(),
+                [&monitor](const std::shared_ptr<MonitorDelivery>& delivery) { return &delivery->getMonitor() == &monitor; });
+        }
+
+        /// wakes the router thread, the mutex is only taken if it sleeps
+        void wakeUp()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_sleeping.load())
+            {
+                std::lock_guard<std::mutex> lock(_sleep_mutex);
+                _wakeup.notify_one();
+            }
+        }
+
+        void push(MonitorEvent::Type type,
+                  timestamp_t simulation_time,
+                  logging::Category category,
+                  logging::Severity severity,
+                  tState state,
+                  const LogText& participant_name,
+                  const LogText& logger_name,
+                  const LogText& message)
+        {
+            const timestamp_t time = LogClock::get().now(_resolution.load(std::memory_order_relaxed));
+            while (!_stop.load(std::memory_order_relaxed))
+            {
+                // a pop after this count makes room, the blocking wait below checks it
+                const size_t pop_count = _ring.getPopCount();
+                if (_ring.tryPush(type, time, simulation_time, category, severity, state, participant_name, logger_name, message))
+                {
+                    wakeUp();
+                    return;
+                }
+                auto policy = _policy.load(std::memory_order_relaxed);
+                // the monitors and the tick task of the router must not wait for themselves
+                if (policy == MonitorOverflowPolicy::block
+                    && (MonitorDelivery::isDeliveryThread() || isRouterThread()))
+                {
+                    policy = MonitorOverflowPolicy::drop_oldest;
+                }
+                switch (policy)
+                {
+                case MonitorOverflowPolicy::block:
+                    wakeUp();
+                    waitForSpace(pop_count);
+                    break;
+                case MonitorOverflowPolicy::drop_newest:
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                default:
+                    if (_ring.tryPop(nullptr))
+                    {
+                        _dropped.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    break;
+                }
+            }
+        }
+
+        /// waits until the router took an event after @p pop_count or the dispatcher stops
+        void waitForSpace(size_t pop_count)
+        {
+            _space_waiters.fetch_add(1);
+            {
+                std::unique_lock<std::mutex> lock(_space_mutex);
+                while (_ring.getPopCount() == pop_count && !_stop.load())
+                {
+                    // the timeout is a safety net only, the router notifies after every pop
+                    _space_available.wait_for(lock, getTickInterval());
+                }
+            }
+            _space_waiters.fetch_sub(1);
+        }
+
+        /// wakes the producers waiting for space, the mutex is only taken if one waits
+        void notifySpace()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_space_waiters.load() > 0)
+            {
+                std::lock_guard<std::mutex> lock(_space_mutex);
+                _space_available.notify_all();
+            }
+        }
+
+        std::shared_ptr<const Deliveries> getDeliveries() const
+        {
+            std::lock_guard<std::mutex> lock(_deliveries_mutex);
+            return _deliveries;
+        }
+
+        /**
+         * @brief publishes that all events taken from the ring before @p pop_count are routed
+         * (or dropped), the mutex is only taken if flush waits
+         */
+        void setRouted(size_t pop_count)
+        {
+            _routed.store(pop_count);
+            if (_flush_waiters.load() > 0)
+            {
+                std::lock_guard<std::mutex> lock(_flush_mutex);
+                _flushed.notify_all();
+            }
+        }
+
+        static bool& routerThreadFlag()
+        {
+            static thread_local bool is_router_thread = false;
+            return is_router_thread;
+        }
+
+        static bool isRouterThread()
+        {
+            return routerThreadFlag();
+        }
+
+        /// runs the tick task if it is due
+        void tick(std::chrono::steady_clock::time_point& next_tick)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (now < next_tick)
+            {
+                return;
+            }
+            next_tick = now + getTickInterval();
+            std::lock_guard<std::mutex> lock(_tick_mutex);
+            if (_tick_task)
+            {
+                _tick_task();
+            }
+        }
+
+        void route()
+        {
+            routerThreadFlag() = true;
+            auto next_tick = std::chrono::steady_clock::now() + getTickInterval();
+            size_t routed_since_tick = 0;
+            MonitorEvent event;
+            while (true)
+            {
+                // the time is only taken every 256 events while routing
+                if (++routed_since_tick >= 256)
+                {
+                    routed_since_tick = 0;
+                    tick(next_tick);
+                }
+                if (_ring.tryPop(&event))
+                {
+                    // the router is the only one taking events to route, the others taken were dropped
+                    const size_t pop_count = _ring.getPopCount();
+                    notifySpace();
+                    const std::shared_ptr<const MonitorEvent> shared_event = std::make_shared<MonitorEvent>(std::move(event));
+                    const size_t dropped = _dropped.exchange(0, std::memory_order_relaxed);
+                    const size_t capacity = _capacity.load(std::memory_order_relaxed);
+                    const auto policy = _policy.load(std::memory_order_relaxed);
+                    const auto deliveries = getDeliveries();
+                    for (const auto& delivery : *deliveries)
+                    {
+                        if (dropped > 0)
+                        {
+                            delivery->addDropped(dropped);
+                        }
+                        if (delivery->accepts(*shared_event))
+                        {
+                            delivery->push(shared_event, capacity, policy);
+                        }
+                    }
+                    setRouted(pop_count);
+                    continue;
+                }
+                setRouted(_ring.getPopCount());
+                tick(next_tick);
+                if (_stop.load())
+                {
+                    //stopped and everything is routed
+                    return;
+                }
+
+                std::unique_lock<std::mutex> lock(_sleep_mutex);
+                _sleeping.store(true);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (_ring.isEmpty() && !_stop.load())
+                {
+                    // a producer publishing now sees sleeping and notifies, the timeout is a safety net only
+                    _wakeup.wait_for(lock, getTickInterval());
+                }
+                _sleeping.store(false);
+            }
+        }
+
+        const std::string _system_name;
+        LogRing _ring;
+        std::atomic<size_t> _capacity{ 1 };
+        std::atomic<MonitorOverflowPolicy> _policy{ MonitorOverflowPolicy::drop_oldest };
+        std::atomic<MonitorTimeResolution> _resolution{ MonitorTimeResolution::microseconds };
+        std::atomic<size_t> _dropped{ 0 };
+        std::atomic<bool> _stop{ false };
+        std::atomic<bool> _sleeping{ false };
+        std::mutex _sleep_mutex;
+        std::condition_variable _wakeup;
+        /// producers blocked by a full ring wait here until the router took an event
+        std::atomic<size_t> _space_waiters{ 0 };
+        std::mutex _space_mutex;
+        std::condition_variable _space_available;
+        /// count of the events taken from the ring which are routed or dropped, flush waits for it
+        std::atomic<size_t> _routed{ 0 };
+        mutable std::atomic<size_t> _flush_waiters{ 0 };
+        mutable std::mutex _flush_mutex;
+        mutable std::condition_variable _flushed;
+        std::mutex _tick_mutex;
+        std::function<void()> _tick_task;
+
+        /// guards _deliveries, the list is replaced on changes, so the router uses it without the lock
+        mutable std::mutex _deliveries_mutex;
+        std::shared_ptr<const Deliveries> _deliveries;
+        std::thread _router;
+    };
+}
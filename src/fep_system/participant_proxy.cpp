@@ -92,6 +92,21 @@ namespace fep
         return  _impl->getAdditionalInfo(key, value_default);
     }
 
+    bool ParticipantProxy::isStandalone() const
+    {
+        return _impl->isStandalone();
+    }
+
+    void ParticipantProxy::invalidateCache() const
+    {
+        _impl->invalidateCache();
+    }
+
+    DiscoveredParticipant ParticipantProxy::getMetadata() const
+    {
+        return _impl->getMetadata();
+    }
+
     bool ParticipantProxy::getRPCComponentProxy(const std::string& component_name,
                                                 const std::string& component_iid,
                                                 IRPCComponentPtr& proxy_ptr) const
@@ -0,0 +1,135 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <future>
+#include <exception>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+#include "fep_system/participant_proxy.h"
+
+namespace fep
+{
+    /// @cond no_doc
+    namespace detail
+    {
+        /// count of the concurrent tasks per hardware thread, the tasks mostly wait for the participants
+        static const size_t tasks_per_hardware_thread = 4;
+
+        template<typename ResultType, typename Item, typename GetName, typename Task>
+        std::map<std::string, ResultType> runForEach(const std::vector<Item>& items, GetName get_name, Task& task)
+        {
+            struct Outcome
+            {
+                ResultType result;
+                std::exception_ptr exception;
+            };
+            std::vector<Outcome> outcomes(items.size());
+            std::atomic<size_t> next_item{ 0 };
+            auto work = [&]()
+            {
+                for (size_t idx = next_item++; idx < items.size(); idx = next_item++)
+                {
+                    try
+                    {
+                        outcomes[idx].result = task(items[idx]);
+                    }
+                    catch (...)
+                    {
+                        outcomes[idx].exception = std::current_exception();
+                    }
+                }
+            };
+
+            const size_t worker_count = std::min(items.size(),
+                std::max<size_t>(std::thread::hardware_concurrency(), 1) * tasks_per_hardware_thread);
+            // the calling thread is one of the workers
+            std::vector<std::future<void>> workers;
+            for (size_t worker = 1; worker < worker_count; ++worker)
+            {
+                workers.push_back(std::async(std::launch::async, work));
+            }
+            work();
+            for (auto& worker : workers)
+            {
+                worker.get();
+            }
+
+            std::map<std::string, ResultType> results;
+            for (size_t idx = 0; idx < items.size(); ++idx)
+            {
+                if (outcomes[idx].exception)
+                {
+                    std::rethrow_exception(outcomes[idx].exception);
+                }
+                results[get_name(items[idx])] = std::move(outcomes[idx].result);
+            }
+            return results;
+        }
+    }
+    /// @endcond no_doc
+
+    /**
+     * @brief Runs @p task for every participant on asynchronous tasks.
+     *
+     * At most tasks_per_hardware_thread tasks per hardware thread run, each takes the next participant
+     * when it finished the previous one. All tasks are awaited before the results are evaluated, so no task is running anymore
+     * when this function returns or throws.
+     *
+     * @tparam ResultType the result type of @p task
+     * @param participants the participants to run the task for
+     * @param task callable with signature ResultType(const ParticipantProxy&)
+     * @return the results by participant name
+     * @throw the first exception (in participant order) one of the tasks has thrown
+     */
+    template<typename ResultType, typename Task>
+    std::map<std::string, ResultType> runForEachParticipant(const std::vector<ParticipantProxy>& participants,
+                                                            Task task)
+    {
+        return detail::runForEach<ResultType>(participants,
+            [](const ParticipantProxy& participant)
+            {
+                return participant.getName();
+            }, task);
+    }
+
+    /**
+     * @brief Runs @p task for every participant name on asynchronous tasks,
+     * for participants no proxy was created for yet (see the overload for the proxies).
+     *
+     * @param participant_names the names of the participants to run the task for
+     * @param task callable with signature ResultType(const std::string&)
+     * @return the results by participant name
+     * @throw the first exception (in participant order) one of the tasks has thrown
+     */
+    template<typename ResultType, typename Task>
+    std::map<std::string, ResultType> runForEachParticipant(const std::vector<std::string>& participant_names,
+                                                            Task task)
+    {
+        return detail::runForEach<ResultType>(participant_names,
+            [](const std::string& participant_name)
+            {
+                return participant_name;
+            }, task);
+    }
+}
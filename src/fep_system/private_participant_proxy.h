@@ -18,9 +18,14 @@ You may add additional accurate notices of copyright ownership.
 */
 #pragma once
 #include <string>
+#include <vector>
+#include <map>
+#include <mutex>
 #include <fep_participant_sdk.h>
 #include "connection_interface.h"
 #include "system_logger_intf.h"
+#include "rpc_metrics.h"
+#include "trace_recorder.h"
 
 #include "rpc_components/participant_info_proxy.h"
 #include "rpc_components/state_machine_proxy.h"
@@ -42,7 +47,13 @@ namespace fep
             _logger(logger),
             _init_priority(0),
             _start_priority(0),
-            _default_timeout(default_timeout)
+            _default_timeout(default_timeout),
+            _property_watcher(std::make_shared<PropertyWatcher>(participant_name, logger, [this]()
+            {
+                rpc_component<fep::rpc::IRPCConfiguration> configuration;
+                getRPCComponentProxyByIID(fep::rpc::IRPCConfiguration::getRPCIID(), configuration, false);
+                return configuration;
+            }))
         {
         }
         virtual ~PrivateParticipantProxy()
@@ -78,6 +89,21 @@ namespace fep
             getRPCComponentProxyByIID(rpc::IRPCParticipantInfo::getRPCIID(), info, false);
             return info;
         }
+
+        /// the participant info connected on construction, connected again if it was not reachable or invalidated
+        rpc_component<fep::rpc::IRPCParticipantInfo> getParticipantInfo() const
+        {
+            std::lock_guard<std::recursive_mutex> lock(_cache_mutex);
+            if (!static_cast<bool>(_info))
+            {
+                _info = getConnection();
+                if (!static_cast<bool>(_info))
+                {
+                    throw std::runtime_error{ "The participant info of the participant is not available: " + _participant_name };
+                }
+            }
+            return _info;
+        }
         
         std::string getParticipantName()
         {
@@ -123,21 +149,9 @@ namespace fep
             //in 2.3 we have a rpc_info (see element_object) and the AI Interface
             //in 2.4 we have can use a new participant info 
             //this must be reworked to be more generic and a real factory !
-            double version;            
-            auto res = _coin.getAI().GetParticipantFEPVersion(version, _participant_name);
-            if (fep::ERR_TIMEOUT == res)
-            {
-                _logger.log(logging::CATEGORY_PARTICIPANT, logging::SEVERITY_FATAL, _participant_name,
-                    _system_name, "Participant was not reachable: " + _participant_name);
-                throw std::runtime_error{ "Participant was not reachable: " + _participant_name };
-            }
-            else if (isFailed(res))
-            {
-                _logger.log(logging::CATEGORY_PARTICIPANT, logging::SEVERITY_FATAL, _participant_name,
-                    _system_name, "Can't determine the version of the participant: " + _participant_name );
-                throw std::runtime_error{ "Can't determine the version of the participant: " + _participant_name };
-            }
-            
+            TraceScope trace("participant", "resolve proxy", _participant_name, component_iid);
+            const double version = getFEPVersion();
+
             /// the participant info is always wrapped within FEP 2 (i think)
             if (component_iid == getRPCIID<fep::rpc::IRPCParticipantInfo>())
             {
@@ -216,7 +230,8 @@ namespace fep
                             part_object.reset(new ConfigurationProxyOldSql(_participant_name.c_str(),
                                 _logger,
                                 fep::rpc::IRPCConfiguration::getRPCDefaultName(),
-                                _default_timeout));
+                                _default_timeout,
+                                _property_watcher));
                             return proxy_ptr.reset(part_object);
                         }
                     }
@@ -234,7 +249,8 @@ namespace fep
                             found_component_name,
                             _coin.getAI().getInternalRPC(),
                             _logger,
-                            _ai_if_less);
+                            _ai_if_less,
+                            _property_watcher);
                         return proxy_ptr.reset(part_object);
                     }
                 }
@@ -244,28 +260,122 @@ namespace fep
 
         std::string getComponentNameWhichSupports(std::string iid) const
         {
-            std::vector<std::string> found_objects;
-            rpc_component<fep::rpc::IRPCParticipantInfo> use_info = _info;
-            if (!static_cast<bool>(use_info))
+            for (const auto& current_object : getRPCComponents())
             {
-                use_info = getConnection();
-            }
-            found_objects = use_info->getRPCComponents();
-            for (const auto& current_object : found_objects)
-            {
-                std::vector<std::string> found_interfaces;
-                found_interfaces = _info->getRPCComponentIIDs(current_object);
-                for (const auto& current_iid : found_interfaces)
+                for (const auto& current_iid : current_object.second)
                 {
                     if (iid == current_iid)
                     {
-                        return current_object;
+                        return current_object.first;
                     }
                 }
             }
             return std::string();
         }
 
+        double getFEPVersion() const
+        {
+            std::lock_guard<std::recursive_mutex> lock(_cache_mutex);
+            if (!_fep_version_cached)
+            {
+                fep::Result res;
+                {
+                    RPCCallScope call(_participant_name, "automation_interface", "GetParticipantFEPVersion");
+                    res = _coin.getAI().GetParticipantFEPVersion(_fep_version, _participant_name);
+                    if (isFailed(res))
+                    {
+                        call.setFailed();
+                    }
+                }
+                if (fep::ERR_TIMEOUT == res)
+                {
+                    _logger.log(logging::CATEGORY_PARTICIPANT, logging::SEVERITY_FATAL, _participant_name,
+                        _system_name, "Participant was not reachable: " + _participant_name);
+                    throw std::runtime_error{ "Participant was not reachable: " + _participant_name };
+                }
+                else if (isFailed(res))
+                {
+                    _logger.log(logging::CATEGORY_PARTICIPANT, logging::SEVERITY_FATAL, _participant_name,
+                        _system_name, "Can't determine the version of the participant: " + _participant_name );
+                    throw std::runtime_error{ "Can't determine the version of the participant: " + _participant_name };
+                }
+                _fep_version_cached = true;
+            }
+            return _fep_version;
+        }
+
+        /// the components and their interfaces, an empty reply (not reachable) is not cached
+        std::map<std::string, std::vector<std::string>> getRPCComponents() const
+        {
+            std::lock_guard<std::recursive_mutex> lock(_cache_mutex);
+            if (_rpc_components.empty())
+            {
+                const auto use_info = getParticipantInfo();
+                for (const auto& current_object : use_info->getRPCComponents())
+                {
+                    _rpc_components[current_object] = use_info->getRPCComponentIIDs(current_object);
+                }
+            }
+            return _rpc_components;
+        }
+
+        /// the system name the participant reports, an empty reply (not reachable) is not cached
+        std::string getReportedSystemName() const
+        {
+            std::lock_guard<std::recursive_mutex> lock(_cache_mutex);
+            if (_reported_system_name.empty())
+            {
+                _reported_system_name = getParticipantInfo()->getSystemName();
+            }
+            return _reported_system_name;
+        }
+
+        DiscoveredParticipant getMetadata() const
+        {
+            DiscoveredParticipant metadata;
+            metadata.name = _participant_name;
+            metadata.fep_version = getFEPVersion();
+            metadata.system_name = getReportedSystemName();
+            metadata.rpc_components = getRPCComponents();
+            metadata.standalone = isStandalone();
+            return metadata;
+        }
+
+        bool isStandalone() const
+        {
+            std::lock_guard<std::recursive_mutex> lock(_cache_mutex);
+            if (!_standalone_cached)
+            {
+                rpc_component<fep::rpc::IRPCConfiguration> configuration;
+                getRPCComponentProxyByIID(fep::rpc::IRPCConfiguration::getRPCIID(), configuration, false);
+                if (!static_cast<bool>(configuration))
+                {
+                    throw std::runtime_error{ "The configuration of the participant is not available: " + _participant_name };
+                }
+                auto properties = configuration->getProperties(
+                    PropertyPath::parseAny(FEP_COMPONENT_CONFIG_STATEMACHINE).toServicePath());
+                _standalone = DefaultPropertyTypeConversion<bool>::fromString(
+                    properties->getProperty(FEP_STM_STANDALONE_FIELD));
+                _standalone_cached = true;
+            }
+            return _standalone;
+        }
+
+        /// also connects the participant info and the property watcher again, the watched properties are kept
+        void invalidateCache()
+        {
+            {
+                std::lock_guard<std::recursive_mutex> lock(_cache_mutex);
+                _info.reset();
+                _fep_version_cached = false;
+                _rpc_components.clear();
+                _reported_system_name.clear();
+                _standalone_cached = false;
+            }
+            // outside of the cache lock, the watcher connects through getRPCComponentProxyByIID
+            _property_watcher->reconnect();
+        }
+
         void setAdditionalInfo(const std::string& key, const std::string& value)
         {
             _additional_info[key] = value;
@@ -289,10 +399,21 @@ namespace fep
         ISystemLogger& _logger;
         std::string _participant_name;
         std::string _system_name;
-        rpc_component<fep::rpc::IRPCParticipantInfo> _info;
+        mutable rpc_component<fep::rpc::IRPCParticipantInfo> _info;
         int32_t _init_priority;
         int32_t _start_priority;
         timestamp_t _default_timeout;
         std::map<std::string, std::string> _additional_info;
+        /// the values read from the participant, valid until invalidateCache;
+        /// recursive since the cached values are read through proxies resolved with the cached version
+        mutable std::recursive_mutex _cache_mutex;
+        mutable bool _fep_version_cached = false;
+        mutable double _fep_version = 0.0;
+        mutable std::map<std::string, std::vector<std::string>> _rpc_components;
+        mutable std::string _reported_system_name;
+        mutable bool _standalone_cached = false;
+        mutable bool _standalone = false;
+        /// shared by all configuration proxies of the participant, destroyed first since its poller uses this
+        std::shared_ptr<PropertyWatcher> _property_watcher;
     };
 }
@@ -0,0 +1,302 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+#include "base/properties/property_type.h"
+#include "base/properties/property_type_conversion.h"
+
+namespace fep
+{
+    /**
+     * @brief Compact encoding of array property values: the elements are packed little endian
+     * (bool as one byte, int32 as four bytes, double as IEEE 754 eight bytes) and the buffer is base64 encoded.
+     *
+     * The encoding is used only for participants which announce the support by the property
+     * binary_array::capability_path, all others will get the comma separated string representation.
+     */
+    namespace binary_array
+    {
+        /// boolean property announcing that the configuration service accepts and delivers binary encoded arrays
+        static const char* const capability_path = "/ComponentConfig/Configuration/bBinaryArrays";
+        /// appended to the array type name to mark the binary encoding
+        static const char* const type_suffix = "-base64";
+
+        /**
+         * @brief type name of the binary encoded array of element type @p T
+         */
+        template<typename T>
+        std::string getTypeName()
+        {
+            return PropertyType<std::vector<T>>::getTypeName() + type_suffix;
+        }
+
+        inline void packElement(std::string& buffer, bool value)
+        {
+            buffer.push_back(value ? '\x01' : '\x00');
+        }
+        inline void packElement(std::string& buffer, int32_t value)
+        {
+            const auto bits = static_cast<uint32_t>(value);
+            for (int byte = 0; byte < 4; ++byte)
+            {
+                buffer.push_back(static_cast<char>((bits >> (byte * 8)) & 0xFF));
+            }
+        }
+        inline void packElement(std::string& buffer, double value)
+        {
+            uint64_t bits;
+            static_assert(sizeof(bits) == sizeof(value), "double is expected to be IEEE 754 binary64");
+            std::memcpy(&bits, &value, sizeof(bits));
+            for (int byte = 0; byte < 8; ++byte)
+            {
+                buffer.push_back(static_cast<char>((bits >> (byte * 8)) & 0xFF));
+            }
+        }
+
+        inline size_t getElementSize(const bool*)
+        {
+            return 1;
+        }
+        inline size_t getElementSize(const int32_t*)
+        {
+            return 4;
+        }
+        inline size_t getElementSize(const double*)
+        {
+            return 8;
+        }
+
+        inline uint64_t unpackBits(const unsigned char* data, size_t size)
+        {
+            uint64_t bits = 0;
+            for (size_t byte = 0; byte < size; ++byte)
+            {
+                bits |= static_cast<uint64_t>(data[byte]) << (byte * 8);
+            }
+            return bits;
+        }
+        inline void unpackElement(const unsigned char* data, bool& value)
+        {
+            value = data[0] != 0;
+        }
+        inline void unpackElement(const unsigned char* data, int32_t& value)
+        {
+            value = static_cast<int32_t>(static_cast<uint32_t>(unpackBits(data, 4)));
+        }
+        inline void unpackElement(const unsigned char* data, double& value)
+        {
+            const uint64_t bits = unpackBits(data, 8);
+            std::memcpy(&value, &bits, sizeof(value));
+        }
+
+        inline std::string toBase64(const std::string& buffer)
+        {
+            static const char* const alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            std::string encoded;
+            encoded.reserve((buffer.size() + 2) / 3 * 4);
+            size_t idx = 0;
+            for (; idx + 2 < buffer.size(); idx += 3)
+            {
+                const uint32_t triple = (static_cast<unsigned char>(buffer[idx]) << 16)
+                    | (static_cast<unsigned char>(buffer[idx + 1]) << 8)
+                    | static_cast<unsigned char>(buffer[idx + 2]);
+                encoded.push_back(alphabet[(triple >> 18) & 0x3F]);
+                encoded.push_back(alphabet[(triple >> 12) & 0x3F]);
+                encoded.push_back(alphabet[(triple >> 6) & 0x3F]);
+                encoded.push_back(alphabet[triple & 0x3F]);
+            }
+            const size_t rest = buffer.size() - idx;
+            if (rest > 0)
+            {
+                uint32_t triple = static_cast<unsigned char>(buffer[idx]) << 16;
+                if (rest == 2)
+                {
+                    triple |= static_cast<unsigned char>(buffer[idx + 1]) << 8;
+                }
+                encoded.push_back(alphabet[(triple >> 18) & 0x3F]);
+                encoded.push_back(alphabet[(triple >> 12) & 0x3F]);
+                encoded.push_back(rest == 2 ? alphabet[(triple >> 6) & 0x3F] : '=');
+                encoded.push_back('=');
+            }
+            return encoded;
+        }
+
+        inline int getBase64Value(char current)
+        {
+            if (current >= 'A' && current <= 'Z')
+            {
+                return current - 'A';
+            }
+            else if (current >= 'a' && current <= 'z')
+            {
+                return current - 'a' + 26;
+            }
+            else if (current >= '0' && current <= '9')
+            {
+                return current - '0' + 52;
+            }
+            else if (current == '+')
+            {
+                return 62;
+            }
+            else if (current == '/')
+            {
+                return 63;
+            }
+            return -1;
+        }
+
+        /**
+         * @brief decodes the canonical base64 encoding as written by toBase64
+         *
+         * @return false on a length which is no multiple of four, a character outside of the alphabet,
+         *         padding which does not match the length of the last group or nonzero padding bits
+         */
+        inline bool fromBase64(const std::string& encoded, std::string& buffer)
+        {
+            if (encoded.size() % 4 != 0)
+            {
+                return false;
+            }
+            buffer.clear();
+            buffer.reserve(encoded.size() / 4 * 3);
+            uint32_t bits = 0;
+            int bit_count = 0;
+            size_t padding = 0;
+            for (const char current : encoded)
+            {
+                if (current == '=')
+                {
+                    ++padding;
+                    continue;
+                }
+                const int value = getBase64Value(current);
+                if (value < 0 || padding > 0)
+                {
+                    return false;
+                }
+                bits = (bits << 6) | static_cast<uint32_t>(value);
+                bit_count += 6;
+                if (bit_count >= 8)
+                {
+                    bit_count -= 8;
+                    buffer.push_back(static_cast<char>((bits >> bit_count) & 0xFF));
+                }
+            }
+            // one '=' leaves 2 bits of the last group, two leave 4 bits, all of them have to be zero
+            return padding <= 2 && static_cast<size_t>(bit_count) == padding * 2
+                && (bits & ((1u << bit_count) - 1)) == 0;
+        }
+
+        /**
+         * @brief encodes the array
+         */
+        template<typename T>
+        std::string encode(const std::vector<T>& value)
+        {
+            std::string buffer;
+            buffer.reserve(value.size() * getElementSize(static_cast<const T*>(nullptr)));
+            for (const auto& element : value)
+            {
+                packElement(buffer, static_cast<T>(element));
+            }
+            return toBase64(buffer);
+        }
+
+        /**
+         * @brief decodes the array
+         *
+         * @return false if @p encoded is no valid encoding of an array of @p T, @p value is unchanged then
+         */
+        template<typename T>
+        bool decode(const std::string& encoded, std::vector<T>& value)
+        {
+            std::string buffer;
+            const size_t element_size = getElementSize(static_cast<const T*>(nullptr));
+            if (!fromBase64(encoded, buffer) || buffer.size() % element_size != 0)
+            {
+                return false;
+            }
+            std::vector<T> decoded;
+            decoded.reserve(buffer.size() / element_size);
+            const auto data = reinterpret_cast<const unsigned char*>(buffer.data());
+            for (size_t offset = 0; offset < buffer.size(); offset += element_size)
+            {
+                T element;
+                unpackElement(data + offset, element);
+                decoded.push_back(element);
+            }
+            value.swap(decoded);
+            return true;
+        }
+    
+        template<typename T>
+        bool toStringRepresentationAs(std::string& type, std::string& value)
+        {
+            std::vector<T> decoded;
+            if (!decode(value, decoded))
+            {
+                return false;
+            }
+            type = PropertyType<std::vector<T>>::getTypeName();
+            value = DefaultPropertyTypeConversion<std::vector<T>>::toString(decoded);
+            return true;
+        }
+
+        /**
+         * @brief returns the type name of the string representation for binary encoded arrays,
+         * other type names are returned unchanged
+         */
+        inline std::string toPlainTypeName(const std::string& type)
+        {
+            if (type == getTypeName<bool>() || type == getTypeName<int32_t>() || type == getTypeName<double>())
+            {
+                return type.substr(0, type.size() - std::strlen(type_suffix));
+            }
+            return type;
+        }
+
+        /**
+         * @brief converts a binary encoded array into the type name and string representation
+         * of the array, other values are left unchanged
+         *
+         * @return false if @p type is a binary array type but @p value can not be decoded
+         */
+        inline bool toStringRepresentation(std::string& type, std::string& value)
+        {
+            if (type == getTypeName<bool>())
+            {
+                return toStringRepresentationAs<bool>(type, value);
+            }
+            else if (type == getTypeName<int32_t>())
+            {
+                return toStringRepresentationAs<int32_t>(type, value);
+            }
+            else if (type == getTypeName<double>())
+            {
+                return toStringRepresentationAs<double>(type, value);
+            }
+            return true;
+        }
+    }
+}
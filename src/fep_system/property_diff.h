@@ -0,0 +1,173 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <algorithm>
+#include <stdexcept>
+
+#include "fep_system/participant_proxy.h"
+#include "fep_system/system_configuration.h"
+#include "base/properties/property_type.h"
+#include "base/properties/property_type_conversion.h"
+#include "property_path.h"
+
+namespace fep
+{
+    /**
+     * @brief splits a full property path into the properties node and the property name
+     * "Clock.MainClock", "/Clock/MainClock" and "Clock/MainClock/" will all result in node "/Clock" and name "MainClock",
+     * invalid paths are split at the last separator as given
+     */
+    inline std::pair<std::string, std::string> splitPropertyPath(const std::string& path)
+    {
+        const auto parsed = PropertyPath::parseAny(path);
+        std::string normalized = parsed.toString();
+        if (!parsed.isValid())
+        {
+            std::replace(normalized.begin(), normalized.end(), '.', '/');
+            if (!normalized.empty() && normalized.at(0) == '/')
+            {
+                normalized = normalized.substr(1);
+            }
+        }
+        const auto last_separator = normalized.rfind('/');
+        if (last_separator == std::string::npos)
+        {
+            return { "/", normalized };
+        }
+        return { "/" + normalized.substr(0, last_separator), normalized.substr(last_separator + 1) };
+    }
+
+    template<typename T>
+    bool isEqualPropertyValueAs(const std::string& lhs, const std::string& rhs)
+    {
+        return DefaultPropertyTypeConversion<T>::fromString(lhs) == DefaultPropertyTypeConversion<T>::fromString(rhs);
+    }
+
+    /**
+     * @brief compares two property values of the given type.
+     * Numbers and booleans are compared by value, so "1.0" and "1.000000" are equal doubles.
+     */
+    inline bool isEqualPropertyValue(const std::string& type, const std::string& lhs, const std::string& rhs)
+    {
+        if (lhs == rhs)
+        {
+            return true;
+        }
+        else if (type == PropertyType<bool>::getTypeName())
+        {
+            return isEqualPropertyValueAs<bool>(lhs, rhs);
+        }
+        else if (type == PropertyType<int32_t>::getTypeName())
+        {
+            return isEqualPropertyValueAs<int32_t>(lhs, rhs);
+        }
+        else if (type == PropertyType<double>::getTypeName())
+        {
+            return isEqualPropertyValueAs<double>(lhs, rhs);
+        }
+        else if (type == PropertyType<std::vector<bool>>::getTypeName())
+        {
+            return isEqualPropertyValueAs<std::vector<bool>>(lhs, rhs);
+        }
+        else if (type == PropertyType<std::vector<int32_t>>::getTypeName())
+        {
+            return isEqualPropertyValueAs<std::vector<int32_t>>(lhs, rhs);
+        }
+        else if (type == PropertyType<std::vector<double>>::getTypeName())
+        {
+            return isEqualPropertyValueAs<std::vector<double>>(lhs, rhs);
+        }
+        return false;
+    }
+
+    /**
+     * @brief reads the current values of all desired properties of one participant
+     * and returns the properties which differ in value or type.
+     * The reads are grouped by properties node, so every node is resolved only once,
+     * and only properties the node reports by name are read, all others are missing and have to be created.
+     *
+     * @param participant_name the name of the participant to read from
+     * @param configuration the configuration proxy of the participant, also used to write the changes
+     * @param desired the desired configuration of the participant
+     * @return the properties to change, old_value is empty if the property does not exist
+     * @throw std::runtime_error if the participant has no configuration
+     */
+    inline std::vector<PropertyChange> diffParticipantConfiguration(const std::string& participant_name,
+                                                                    const rpc_component<rpc::IRPCConfiguration>& configuration,
+                                                                    const ParticipantConfiguration& desired)
+    {
+        if (!configuration)
+        {
+            throw std::runtime_error{ "the configuration of participant " + participant_name + " is not available" };
+        }
+
+        std::map<std::string, std::vector<std::pair<std::string, const PropertyValue*>>> nodes;
+        for (const auto& property : desired)
+        {
+            const auto node_and_name = splitPropertyPath(property.first);
+            nodes[node_and_name.first].emplace_back(node_and_name.second, &property.second);
+        }
+
+        std::vector<PropertyChange> changes;
+        for (const auto& node : nodes)
+        {
+            std::shared_ptr<const IProperties> props;
+            std::set<std::string> existing;
+            try
+            {
+                props = configuration->getProperties(node.first);
+                if (props)
+                {
+                    const auto names = props->getPropertyNames();
+                    existing.insert(names.begin(), names.end());
+                }
+            }
+            catch (const std::runtime_error&)
+            {
+                //the node does not exist yet, so every property of it is a change (the set will report the error)
+            }
+
+            for (const auto& entry : node.second)
+            {
+                const std::string path = (node.first == "/" ? "" : node.first.substr(1) + "/") + entry.first;
+                //missing properties are not read, that would log an error and an empty value equals a desired ""
+                const bool exists = existing.count(entry.first) != 0;
+                std::string current_value;
+                std::string current_type;
+                if (exists)
+                {
+                    current_value = props->getProperty(entry.first);
+                    current_type = props->getPropertyType(entry.first);
+                }
+                //a property of another type is set again, even if its value reads the same (i.e. int32 1 and double 1.0)
+                if (!exists
+                    || current_type != entry.second->type
+                    || !isEqualPropertyValue(entry.second->type, current_value, entry.second->value))
+                {
+                    changes.push_back({ participant_name, path, current_value, entry.second->value, entry.second->type });
+                }
+            }
+        }
+        return changes;
+    }
+}
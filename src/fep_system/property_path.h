@@ -0,0 +1,262 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <string>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <functional>
+
+namespace fep
+{
+    /**
+     * @brief A parsed and validated property path.
+     *
+     * A valid path consists of names of the characters [a-zA-Z0-9_], separated by single separators,
+     * a leading and a trailing separator are allowed ("/Clock/MainClock/", "Clock/MainClock" and "" (root) are valid).
+     * Paths are interned: parsing the same text twice returns the same instance without scanning again,
+     * equal paths share one instance, so comparing usually and hashing always does not touch the characters.
+     */
+    class PropertyPath
+    {
+    public:
+        /**
+         * @brief the root path
+         */
+        PropertyPath() : PropertyPath(parse(std::string()))
+        {
+        }
+
+        /**
+         * @brief parses a path with '/' as separator
+         */
+        static PropertyPath parse(const std::string& text)
+        {
+            return PropertyPath(intern(text, false));
+        }
+
+        /**
+         * @brief parses a path with '/' or '.' as separator
+         */
+        static PropertyPath parseAny(const std::string& text)
+        {
+            return PropertyPath(intern(text, true));
+        }
+
+        bool isValid() const
+        {
+            return _data->valid;
+        }
+
+        bool isRoot() const
+        {
+            return _data->normalized.empty();
+        }
+
+        /**
+         * @brief returns the names separated by @p separator without leading and trailing separator,
+         * for invalid paths the text as given to parse
+         */
+        std::string toString(char separator = '/') const
+        {
+            if (separator == '/' || !_data->valid)
+            {
+                return _data->normalized;
+            }
+            std::string result = _data->normalized;
+            for (auto& current : result)
+            {
+                if (current == '/')
+                {
+                    current = separator;
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief returns the path with leading '/' as used by the configuration service
+         */
+        const std::string& toServicePath() const
+        {
+            return _data->service_path;
+        }
+
+        /**
+         * @brief returns this path extended by @p child
+         */
+        PropertyPath append(const PropertyPath& child) const
+        {
+            if (child.isRoot())
+            {
+                return *this;
+            }
+            else if (isRoot())
+            {
+                return child;
+            }
+            return PropertyPath(intern(_data->normalized + "/" + child._data->normalized, false));
+        }
+
+        size_t getHash() const
+        {
+            return _data->hash;
+        }
+
+        bool operator==(const PropertyPath& other) const
+        {
+            // equal paths share the instance unless the interner was cleared in between
+            return _data == other._data
+                || (_data->hash == other._data->hash
+                    && _data->valid == other._data->valid
+                    && _data->normalized == other._data->normalized);
+        }
+        bool operator!=(const PropertyPath& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        struct Data
+        {
+            bool valid;
+            std::string normalized;
+            std::string service_path;
+            size_t hash;
+        };
+
+        explicit PropertyPath(std::shared_ptr<const Data> data) : _data(std::move(data))
+        {
+        }
+
+        static bool isNameCharacter(char current)
+        {
+            return (current >= 'a' && current <= 'z')
+                || (current >= 'A' && current <= 'Z')
+                || (current >= '0' && current <= '9')
+                || current == '_';
+        }
+
+        /**
+         * @brief scans @p text once, the result is the normalized '/' separated path
+         *
+         * @return false if @p text is no valid path
+         */
+        static bool scan(const std::string& text, bool allow_dots, std::string& normalized)
+        {
+            normalized.clear();
+            normalized.reserve(text.size());
+            bool after_separator = true;
+            for (size_t idx = 0; idx < text.size(); ++idx)
+            {
+                const char current = text[idx];
+                if (current == '/' || (allow_dots && current == '.'))
+                {
+                    // only a single leading separator and no empty names
+                    if (after_separator && idx != 0)
+                    {
+                        return false;
+                    }
+                    after_separator = true;
+                }
+                else if (isNameCharacter(current))
+                {
+                    if (after_separator && !normalized.empty())
+                    {
+                        normalized.push_back('/');
+                    }
+                    normalized.push_back(current);
+                    after_separator = false;
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Keeps one instance per parsed text and per normalized path.
+         * The tables are cleared when they reach max_size, paths parsed before stay valid.
+         */
+        class Interner
+        {
+        public:
+            static const size_t max_size = 16384;
+
+            std::shared_ptr<const Data> get(const std::string& text, bool allow_dots)
+            {
+                std::string key(1, allow_dots ? '.' : '/');
+                key.append(text);
+                std::lock_guard<std::mutex> lock(_mutex);
+                const auto parsed = _parsed.find(key);
+                if (parsed != _parsed.end())
+                {
+                    return parsed->second;
+                }
+
+                if (_parsed.size() >= max_size || _canonical.size() >= max_size)
+                {
+                    _parsed.clear();
+                    _canonical.clear();
+                }
+                std::string normalized;
+                const bool valid = scan(text, allow_dots, normalized);
+                auto& canonical = _canonical[valid ? normalized : "\n" + text];
+                if (!canonical)
+                {
+                    auto data = std::make_shared<Data>();
+                    data->valid = valid;
+                    data->normalized = valid ? normalized : text;
+                    data->service_path = valid ? "/" + normalized : text;
+                    data->hash = std::hash<std::string>()(data->normalized);
+                    canonical = data;
+                }
+                _parsed.emplace(std::move(key), canonical);
+                return canonical;
+            }
+
+        private:
+            std::mutex _mutex;
+            std::unordered_map<std::string, std::shared_ptr<const Data>> _parsed;
+            std::unordered_map<std::string, std::shared_ptr<const Data>> _canonical;
+        };
+
+        static std::shared_ptr<const Data> intern(const std::string& text, bool allow_dots)
+        {
+            static Interner interner;
+            return interner.get(text, allow_dots);
+        }
+
+        std::shared_ptr<const Data> _data;
+    };
+}
+
+namespace std
+{
+    template<>
+    struct hash<fep::PropertyPath>
+    {
+        size_t operator()(const fep::PropertyPath& path) const
+        {
+            return path.getHash();
+        }
+    };
+}
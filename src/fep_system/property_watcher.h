@@ -0,0 +1,279 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+
+#include "fep_system/rpc_component_proxy.h"
+#include "fep_system/system_logger_intf.h"
+#include "rpc_components/configuration/configuration_rpc_intf.h"
+#include "property_diff.h"
+
+#include <a_util/strings.h>
+
+namespace fep
+{
+    /**
+     * @brief Watches properties of one participant for all its configuration proxies.
+     *
+     * All watched properties are read by one poller thread, every property once per cycle
+     * no matter how many listeners are registered for it, and the reads are grouped by properties node.
+     * Neither the FEP 2 automation interface nor the FEP 3 configuration service send property change
+     * notifications, so the poller is the only source of changes.
+     */
+    class PropertyWatcher
+    {
+    public:
+        /// creates the configuration proxy the watched properties are read with
+        using Connect = std::function<rpc_component<rpc::IRPCConfiguration>()>;
+
+        PropertyWatcher(std::string participant_name,
+                        ISystemLogger& logger,
+                        Connect connect,
+                        std::chrono::milliseconds poll_interval = std::chrono::milliseconds(250)) :
+            _participant_name(std::move(participant_name)),
+            _logger(logger),
+            _connect(std::move(connect)),
+            _poll_interval(poll_interval)
+        {
+        }
+        ~PropertyWatcher()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _wakeup.notify_all();
+            if (_poller.joinable())
+            {
+                _poller.join();
+            }
+        }
+        PropertyWatcher(const PropertyWatcher&) = delete;
+        PropertyWatcher(PropertyWatcher&&) = delete;
+        PropertyWatcher& operator=(const PropertyWatcher&) = delete;
+        PropertyWatcher& operator=(PropertyWatcher&&) = delete;
+
+        /**
+         * @brief registers @p listener for changes of the property, the current value is the reference
+         *
+         * @param property_path full path of the property ('.' or '/' separated)
+         * @param listener the listener, it is called from the poller thread
+         *
+         * May be called from within a listener, the notify lock is not taken:
+         * a change detected by a cycle running concurrently may already be passed to the new listener.
+         */
+        void registerListener(const std::string& property_path, rpc::IPropertyChangeListener& listener)
+        {
+            const auto path = normalizePath(property_path);
+            // read the reference value before the listener is known to the poller
+            std::map<std::string, std::string> current_values;
+            readValues({ path }, current_values);
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto& watched = _watched[path];
+            if (watched.listeners.empty())
+            {
+                const auto current_value = current_values.find(path);
+                watched.readable = current_value != current_values.end();
+                watched.value = watched.readable ? current_value->second : std::string();
+            }
+            watched.listeners.insert(&listener);
+            if (!_poller.joinable())
+            {
+                _poller = std::thread([this]() { poll(); });
+            }
+        }
+
+        /**
+         * @brief unregisters @p listener, it will not be called anymore when this function returns.
+         * Must not be called from within a listener, it waits for the listeners being called.
+         */
+        void unregisterListener(const std::string& property_path, rpc::IPropertyChangeListener& listener)
+        {
+            const auto path = normalizePath(property_path);
+            std::lock_guard<std::mutex> notify_lock(_notify_mutex);
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto watched = _watched.find(path);
+            if (watched != _watched.end())
+            {
+                watched->second.listeners.erase(&listener);
+                if (watched->second.listeners.empty())
+                {
+                    _watched.erase(watched);
+                }
+            }
+        }
+
+        /**
+         * @brief drops the configuration proxy, the next cycle connects the participant again (i.e. after a restart)
+         */
+        void reconnect()
+        {
+            std::lock_guard<std::mutex> lock(_read_mutex);
+            _configuration.reset();
+        }
+
+    private:
+        struct WatchedProperty
+        {
+            bool readable = false;
+            std::string value;
+            std::set<rpc::IPropertyChangeListener*> listeners;
+        };
+
+        static std::string normalizePath(const std::string& property_path)
+        {
+            const auto node_and_name = splitPropertyPath(property_path);
+            return (node_and_name.first == "/" ? "" : node_and_name.first.substr(1) + "/") + node_and_name.second;
+        }
+
+        /**
+         * @brief reads the values of the given properties, every node is requested once.
+         * Properties which can not be read are missing in @p values.
+         */
+        void readValues(const std::vector<std::string>& paths, std::map<std::string, std::string>& values)
+        {
+            std::map<std::string, std::vector<std::string>> nodes;
+            for (const auto& path : paths)
+            {
+                const auto node_and_name = splitPropertyPath(path);
+                nodes[node_and_name.first].push_back(node_and_name.second);
+            }
+
+            std::lock_guard<std::mutex> lock(_read_mutex);
+            try
+            {
+                if (!_configuration)
+                {
+                    _configuration = _connect();
+                }
+                if (!_configuration)
+                {
+                    return;
+                }
+                for (const auto& node : nodes)
+                {
+                    std::shared_ptr<const IProperties> props;
+                    try
+                    {
+                        props = _configuration->getProperties(node.first);
+                    }
+                    catch (const std::runtime_error&)
+                    {
+                        //the node does not exist (yet)
+                        continue;
+                    }
+                    const auto existing = props->getPropertyNames();
+                    for (const auto& name : node.second)
+                    {
+                        if (std::find(existing.begin(), existing.end(), name) != existing.end())
+                        {
+                            values[(node.first == "/" ? "" : node.first.substr(1) + "/") + name] = props->getProperty(name);
+                        }
+                    }
+                }
+            }
+            catch (const std::exception& ex)
+            {
+                //the participant is not reachable, connect again within the next cycle
+                _configuration.reset();
+                _logger.logLazy(logging::CATEGORY_PARTICIPANT, logging::SEVERITY_WARNING, _participant_name, "PropertyWatcher",
+                    [&]() { return a_util::strings::format("Can not read watched properties: %s", ex.what()); });
+            }
+        }
+
+        void poll()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (!_stop)
+            {
+                _wakeup.wait_for(lock, _poll_interval, [this]() { return _stop; });
+                if (_stop || _watched.empty())
+                {
+                    continue;
+                }
+                std::vector<std::string> paths;
+                for (const auto& watched : _watched)
+                {
+                    paths.push_back(watched.first);
+                }
+                lock.unlock();
+
+                std::map<std::string, std::string> current_values;
+                readValues(paths, current_values);
+
+                {
+                    std::lock_guard<std::mutex> notify_lock(_notify_mutex);
+                    std::vector<std::pair<std::string, std::string>> changes;
+                    std::vector<std::set<rpc::IPropertyChangeListener*>> listeners;
+                    {
+                        std::lock_guard<std::mutex> update_lock(_mutex);
+                        for (const auto& current_value : current_values)
+                        {
+                            auto watched = _watched.find(current_value.first);
+                            if (watched != _watched.end()
+                                && (!watched->second.readable || watched->second.value != current_value.second))
+                            {
+                                watched->second.readable = true;
+                                watched->second.value = current_value.second;
+                                changes.emplace_back(current_value.first, current_value.second);
+                                listeners.push_back(watched->second.listeners);
+                            }
+                        }
+                    }
+                    for (size_t idx = 0; idx < changes.size(); ++idx)
+                    {
+                        for (auto listener : listeners[idx])
+                        {
+                            listener->onPropertyChanged(_participant_name, changes[idx].first, changes[idx].second);
+                        }
+                    }
+                }
+                lock.lock();
+            }
+        }
+
+        std::string _participant_name;
+        ISystemLogger& _logger;
+        Connect _connect;
+        std::chrono::milliseconds _poll_interval;
+
+        /// guards _watched and _stop
+        std::mutex _mutex;
+        /// held while listeners are called, so unregistered listeners are not called anymore;
+        /// only unregistering takes it, registering is possible from within a listener
+        std::mutex _notify_mutex;
+        /// guards _configuration, the proxy is used by one thread at a time
+        std::mutex _read_mutex;
+        std::condition_variable _wakeup;
+        bool _stop = false;
+        std::map<std::string, WatchedProperty> _watched;
+        rpc_component<rpc::IRPCConfiguration> _configuration;
+        std::thread _poller;
+    };
+}
@@ -0,0 +1,318 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <stdexcept>
+
+#include <a_util/strings.h>
+#include "fep_system/participant_proxy.h"
+#include "participant_tasks.h"
+#include "property_path.h"
+
+namespace fep
+{
+    /**
+     * @brief One property assignment for one participant, tagged with the plan step it belongs to.
+     */
+    struct PropertyWrite
+    {
+        std::string _node;
+        std::string _name;
+        std::string _value;
+        std::string _type;
+        size_t      _step;
+    };
+
+    /**
+     * @brief Collects the property assignments of a system configuration (e.g. configureTiming)
+     * and compiles them into one ordered write list per participant.
+     *
+     * Each participant list is executed on its own task with one configuration proxy resolution,
+     * so the costs are O(participants) parallel instead of O(properties x participants) serial calls.
+     * Error reporting follows the step order: the first step (in the order it was added)
+     * which failed for any participant is reported, as the former serial calls did.
+     * A properties node which is not accessible fails a step for a single participant,
+     * while steps for every participant skip such participants.
+     */
+    class PropertyWritePlan
+    {
+    public:
+        /**
+         * @brief adds a step which sets the property to every participant of the system
+         *
+         * @param node the properties node
+         * @param name property name, separated by dots or slashes (normalized to slashes without leading and trailing separator)
+         * @param value the value as string
+         * @param type the type name of the property
+         * @param except_participant participant which will not be configured by this step
+         */
+        void addToAll(const std::string& node,
+                      const std::string& name,
+                      const std::string& value,
+                      const std::string& type,
+                      const std::string& except_participant = std::string())
+        {
+            _steps.push_back({ node, normalize(name), value, type, std::string(), except_participant, true });
+        }
+
+        /**
+         * @brief adds a step which sets the property to the given participant only
+         *
+         * @param participant the participant to configure
+         * @param node the properties node
+         * @param name property name, separated by dots or slashes (normalized to slashes without leading and trailing separator)
+         * @param value the value as string
+         * @param type the type name of the property
+         */
+        void addTo(const std::string& participant,
+                   const std::string& node,
+                   const std::string& name,
+                   const std::string& value,
+                   const std::string& type)
+        {
+            _steps.push_back({ node, normalize(name), value, type, participant, std::string(), false });
+        }
+
+        /**
+         * @brief the single participant names the plan addresses explicitly,
+         * each with the name of the first property the plan sets to it
+         */
+        std::vector<std::pair<std::string, std::string>> getAddressedParticipants() const
+        {
+            std::vector<std::pair<std::string, std::string>> addressed;
+            for (const auto& step : _steps)
+            {
+                if (!step._to_all
+                    && std::find_if(addressed.begin(), addressed.end(),
+                        [&step](const std::pair<std::string, std::string>& participant)
+                        {
+                            return participant.first == step._participant;
+                        }) == addressed.end())
+                {
+                    addressed.emplace_back(step._participant, step._name);
+                }
+            }
+            return addressed;
+        }
+
+        bool empty() const
+        {
+            return _steps.empty();
+        }
+
+        /**
+         * @brief compiles the steps into one ordered write list per participant
+         *
+         * @param participants the names of all participants within the system
+         * @return the write lists, participants without any write are not contained
+         */
+        std::map<std::string, std::vector<PropertyWrite>> compile(const std::vector<std::string>& participants) const
+        {
+            std::map<std::string, std::vector<PropertyWrite>> writes;
+            for (size_t step_idx = 0; step_idx < _steps.size(); ++step_idx)
+            {
+                const auto& step = _steps[step_idx];
+                if (step._to_all)
+                {
+                    for (const auto& participant : participants)
+                    {
+                        if (participant != step._except_participant)
+                        {
+                            writes[participant].push_back({ step._node, step._name, step._value, step._type, step_idx });
+                        }
+                    }
+                }
+                else
+                {
+                    writes[step._participant].push_back({ step._node, step._name, step._value, step._type, step_idx });
+                }
+            }
+            return writes;
+        }
+
+        /**
+         * @brief executes the plan, one task per participant
+         *
+         * @param participants all participants of the system
+         * @throw std::runtime_error if one of the properties could not be set,
+         *                           exceptions of the proxy resolution are passed through
+         */
+        void execute(const std::map<std::string, ParticipantProxy>& participants) const
+        {
+            execute(participants, std::map<std::string, rpc_component<rpc::IRPCConfiguration>>());
+        }
+
+        /**
+         * @brief executes the plan with the configuration proxies resolved before (i.e. to read the current values),
+         * participants without one in @p configurations resolve it
+         *
+         * @param participants all participants of the system
+         * @param configurations the resolved configuration proxies by participant name
+         * @throw std::runtime_error if one of the properties could not be set,
+         *                           exceptions of the proxy resolution are passed through
+         */
+        void execute(const std::map<std::string, ParticipantProxy>& participants,
+                     const std::map<std::string, rpc_component<rpc::IRPCConfiguration>>& configurations) const
+        {
+            std::vector<std::string> names;
+            for (const auto& participant : participants)
+            {
+                names.push_back(participant.first);
+            }
+            const auto writes = compile(names);
+
+            std::vector<ParticipantProxy> participants_to_write;
+            for (const auto& participant_writes : writes)
+            {
+                participants_to_write.push_back(participants.at(participant_writes.first));
+            }
+            const auto results = runForEachParticipant<Failure>(participants_to_write,
+                [this, &writes, &configurations](const ParticipantProxy& proxy) -> Failure
+                {
+                    const auto configuration = configurations.find(proxy.getName());
+                    return executeWrites(configuration != configurations.end()
+                            ? configuration->second
+                            : proxy.getRPCComponentProxy<fep::rpc::IRPCConfiguration>(),
+                        writes.at(proxy.getName()));
+                });
+
+            std::map<std::string, Failure> failures;
+            for (const auto& result : results)
+            {
+                if (result.second._step != no_failure)
+                {
+                    failures[result.first] = result.second;
+                }
+            }
+            throwOnFailure(failures);
+        }
+
+    private:
+        static constexpr size_t no_failure = static_cast<size_t>(-1);
+
+        struct Step
+        {
+            std::string _node;
+            std::string _name;
+            std::string _value;
+            std::string _type;
+            std::string _participant;
+            std::string _except_participant;
+            bool        _to_all;
+        };
+
+        /// the first step which failed for one participant
+        struct Failure
+        {
+            size_t _step = no_failure;
+            bool   _node_not_accessible = false;
+        };
+
+        static std::string normalize(const std::string& name)
+        {
+            const auto path = PropertyPath::parseAny(name);
+            if (path.isValid())
+            {
+                return path.toString();
+            }
+            std::string normalized = name;
+            std::replace(normalized.begin(), normalized.end(), '.', '/');
+            return normalized;
+        }
+
+        Failure executeWrites(rpc_component<rpc::IRPCConfiguration> config_rpc_client,
+                              const std::vector<PropertyWrite>& write_list) const
+        {
+            Failure failure;
+            std::map<std::string, std::shared_ptr<IProperties>> nodes;
+            for (const auto& write : write_list)
+            {
+                auto& props = nodes[write._node];
+                if (!props)
+                {
+                    props = config_rpc_client->getProperties(write._node);
+                }
+                if (!props)
+                {
+                    //the participants without the node are skipped by steps for all, as the former serial calls did
+                    if (_steps[write._step]._to_all)
+                    {
+                        continue;
+                    }
+                    failure._step = write._step;
+                    failure._node_not_accessible = true;
+                    return failure;
+                }
+                if (!props->setProperty(write._name, write._value, write._type))
+                {
+                    failure._step = write._step;
+                    return failure;
+                }
+            }
+            return failure;
+        }
+
+        void throwOnFailure(const std::map<std::string, Failure>& failures) const
+        {
+            if (failures.empty())
+            {
+                return;
+            }
+            size_t first_failed_step = no_failure;
+            for (const auto& failed : failures)
+            {
+                first_failed_step = std::min(first_failed_step, failed.second._step);
+            }
+            std::vector<std::string> failing_participants;
+            bool node_not_accessible = false;
+            for (const auto& failed : failures)
+            {
+                if (failed.second._step == first_failed_step)
+                {
+                    failing_participants.push_back(failed.first);
+                    node_not_accessible = failed.second._node_not_accessible;
+                }
+            }
+
+            const auto& step = _steps[first_failed_step];
+            if (node_not_accessible)
+            {
+                throw std::runtime_error(a_util::strings::format("access to properties node %s not possible"
+                    , step._node.c_str()));
+            }
+            else if (step._to_all)
+            {
+                throw std::runtime_error(a_util::strings::format("property %s could not be set for the following participants: %s"
+                    , step._name.c_str()
+                    , a_util::strings::join(failing_participants, ", ").c_str()));
+            }
+            else
+            {
+                throw std::runtime_error(a_util::strings::format("property %s could not be set for the following participant: %s"
+                    , step._name.c_str()
+                    , step._participant.c_str()));
+            }
+        }
+
+        std::vector<Step> _steps;
+    };
+}
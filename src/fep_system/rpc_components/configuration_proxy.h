@@ -18,27 +18,34 @@ You may add additional accurate notices of copyright ownership.
 */
 #pragma once
 #include <string>
-#include <regex>
+#include <mutex>
+#include <algorithm>
 
 #include <fep3/components/rpc/fep_rpc.h>
 //this will be installed !!
 #include "rpc_components/configuration/configuration_rpc_intf.h"
 #include <fep3/rpc_components/configuration/configuration_service_client.h>
 #include "connection_interface.h"
+#include "typed_properties_intf.h"
+#include "property_array_encoding.h"
+#include "property_watcher.h"
+#include "property_path.h"
+#include "rpc_metrics.h"
+#include "trace_recorder.h"
 #include "base/properties/property_type.h"
 #include "base/properties/property_type_conversion.h"
 
 #include <a_util/strings.h>
 
 #define FEP_CONFIG_LOG_RESULT(_res_, _participant_name_, _component_name_, _method_, _path_) { \
-_logger.log(logging::CATEGORY_COMPONENT, logging::SEVERITY_ERROR, _participant_name_, \
+_logger.logLazy(logging::CATEGORY_COMPONENT, logging::SEVERITY_ERROR, _participant_name_, \
 _component_name_, \
-a_util::strings::format("Can not %s '%s' due to following error : (%d - %s)  ", \
+[&]() { return a_util::strings::format("Can not %s '%s' due to following error : (%d - %s)  ", \
     _method_.c_str(), \
     _path_.c_str(), \
     _res_.getErrorCode(), \
     _res_.getErrorLabel(), \
-    _res_.getDescription())); }
+    _res_.getDescription()); }); }
 
 #define FEP_CONFIG_LOG_AND_THROW_RESULT(_res_, _participant_name_, _component_name_, _method_, _path_) \
 FEP_CONFIG_LOG_RESULT(_res_, _participant_name_, _component_name_, _method_, _path_) \
@@ -53,7 +60,7 @@ namespace fep
             typedef rpc_object_proxy< rpc_stubs::RPCConfigurationClient, rpc::IRPCConfiguration> base_type;
             friend class ConnectionInterfaceProperty;
 
-        class ConfigurationProperty : public IProperties
+        class ConfigurationProperty : public IProperties, public ITypedProperties, public IPropertyTreeReader
         {
             std::shared_ptr<const ConfigurationProxy> _clientsafe_ptr;
             rpc_stubs::RPCConfigurationClient& _stub;
@@ -61,7 +68,7 @@ namespace fep
             std::string                       _participant_name;
             std::string                       _component_name;
             ISystemLogger&                    _logger;
-            const std::regex                  _property_path_regex = std::regex("([/]?([a-zA-Z0-9_]+[/]?)*)");
+            PropertyPath                      _node_path;
             AutomationInterface*              _ai_hacky_for_timing_config_check;
 
         public:
@@ -81,6 +88,7 @@ namespace fep
                 _clientsafe_ptr(client),
                 _stub(stub),
                 _property_path(std::move(property_path)),
+                _node_path(PropertyPath::parse(_property_path)),
                 _participant_name(std::move(participant_name)),
                 _component_name(std::move(component_name)),
                 _logger(logger),
@@ -92,8 +100,8 @@ namespace fep
                              const std::string& value,
                              const std::string& type)
             {
-                std::string path = _property_path + normalizeName(name);
-                if (!isPropertyPathValid(path))
+                std::string path;
+                if (!resolvePath(name, path))
                 {
                     fep::Result result(ERR_INVALID_ARG);
                     FEP_CONFIG_LOG_RESULT(result, _participant_name, _component_name, std::string("setProperty"), path);
@@ -101,7 +109,8 @@ namespace fep
                 }
                 else
                 {
-                    int32_t retval = _stub.setProperty(path, type, value);
+                    TraceScope trace("participant", "write property", _participant_name, path);
+                    int32_t retval = callSetProperty(path, type, value);
                     if (retval == 0)
                     {
                         return true;
@@ -140,8 +149,8 @@ namespace fep
             
             std::string getProperty(const std::string& name) const
             {
-                std::string path = _property_path + normalizeName(name);
-                if (!isPropertyPathValid(path))
+                std::string path;
+                if (!resolvePath(name, path))
                 {
                     fep::Result result(ERR_INVALID_ARG);
                     FEP_CONFIG_LOG_RESULT(result, _participant_name, _component_name, std::string("getProperty"), path);
@@ -149,7 +158,8 @@ namespace fep
                 }
                 else
                 {
-                    std::string type = _stub.getProperty(path)["type"].asString();
+                    const auto property = callGetProperty(path);
+                    std::string type = property["type"].asString();
                     if (type.empty())
                     {
                         FEP_CONFIG_LOG_RESULT(fep::Result(ERR_PATH_NOT_FOUND), _participant_name, _component_name, std::string("getProperty"), path);
@@ -157,7 +167,12 @@ namespace fep
                     }
                     else
                     {
-                        std::string value = _stub.getProperty(path)["value"].asString();
+                        std::string value = property["value"].asString();
+                        if (!binary_array::toStringRepresentation(type, value))
+                        {
+                            FEP_CONFIG_LOG_RESULT(fep::Result(ERR_INVALID_TYPE), _participant_name, _component_name, std::string("getProperty"), path);
+                            return "";
+                        }
                         return value;
                     }
                 }
@@ -165,8 +180,8 @@ namespace fep
 
             std::string getPropertyType(const std::string& name) const
             {
-                std::string path = _property_path + normalizeName(name);
-                if (!isPropertyPathValid(path))
+                std::string path;
+                if (!resolvePath(name, path))
                 {
                     fep::Result result(ERR_INVALID_ARG);
                     FEP_CONFIG_LOG_RESULT(result, _participant_name, _component_name, std::string("getPropertyType"), path);
@@ -175,7 +190,7 @@ namespace fep
                 else
                 {
 
-                    std::string type = _stub.getProperty(path)["type"].asString();
+                    std::string type = callGetProperty(path)["type"].asString();
                     if (type.empty())
                     {
                         FEP_CONFIG_LOG_RESULT(fep::Result(ERR_PATH_NOT_FOUND), _participant_name, _component_name, std::string("getPropertyType"), path);
@@ -183,7 +198,7 @@ namespace fep
                     }
                     else
                     {
-                        return type;
+                        return binary_array::toPlainTypeName(type);
                     }
                 }
             }
@@ -195,8 +210,11 @@ namespace fep
                 for (const auto& prop_name : prop_names)
                 {
                     std::string path = _property_path + prop_name;
-                    auto val = _stub.getProperty(path);
-                    mirrored_properties.setProperty(prop_name, val["value"].asString(), val["type"].asString());
+                    auto val = callGetProperty(path);
+                    std::string type = val["type"].asString();
+                    std::string value = val["value"].asString();
+                    binary_array::toStringRepresentation(type, value);
+                    mirrored_properties.setProperty(prop_name, value, type);
                 }
                 return mirrored_properties.isEqual(properties);
             }
@@ -208,53 +226,263 @@ namespace fep
                 for (const auto& prop_name : prop_names)
                 {
                     std::string path = _property_path + prop_name;
-                    auto val = _stub.getProperty(path);
-                    properties.setProperty(prop_name, val["value"].asString(), val["type"].asString());
+                    auto val = callGetProperty(path);
+                    std::string type = val["type"].asString();
+                    std::string value = val["value"].asString();
+                    binary_array::toStringRepresentation(type, value);
+                    properties.setProperty(prop_name, value, type);
                 }
             }
 
             std::vector<std::string> getPropertyNames() const
             {
-                auto props = _stub.getProperties(_property_path);
+                auto props = callGetProperties(_property_path);
                 return a_util::strings::split(props, ",");
             }
 
+            void readTree(ParticipantConfiguration& values) const override
+            {
+                readTree(_property_path, std::string(), values);
+            }
+
+            void readTree(const std::string& node_path, const std::string& prefix, ParticipantConfiguration& values) const
+            {
+                for (const auto& prop_name : a_util::strings::split(callGetProperties(node_path), ","))
+                {
+                    std::string path = node_path + prop_name;
+                    auto val = callGetProperty(path);
+                    std::string type = val["type"].asString();
+                    std::string value = val["value"].asString();
+                    if (!type.empty() && binary_array::toStringRepresentation(type, value))
+                    {
+                        values[prefix + prop_name] = { value, type };
+                    }
+                    readTree(path + "/", prefix + prop_name + "/", values);
+                }
+            }
+
+            bool setTypedProperty(const std::string& name, bool value) override
+            {
+                return setValue(name, value);
+            }
+            bool setTypedProperty(const std::string& name, int32_t value) override
+            {
+                return setValue(name, value);
+            }
+            bool setTypedProperty(const std::string& name, double value) override
+            {
+                return setValue(name, value);
+            }
+            bool setTypedProperty(const std::string& name, const std::string& value) override
+            {
+                return setValue(name, value);
+            }
+            bool setTypedProperty(const std::string& name, const std::vector<bool>& value) override
+            {
+                return setArrayValue(name, value);
+            }
+            bool setTypedProperty(const std::string& name, const std::vector<int32_t>& value) override
+            {
+                return setArrayValue(name, value);
+            }
+            bool setTypedProperty(const std::string& name, const std::vector<double>& value) override
+            {
+                return setArrayValue(name, value);
+            }
+            bool setTypedProperty(const std::string& name, const std::vector<std::string>& value) override
+            {
+                return setValue(name, value);
+            }
+
+            bool getTypedProperty(const std::string& name, bool& value) const override
+            {
+                return getValue(name, value);
+            }
+            bool getTypedProperty(const std::string& name, int32_t& value) const override
+            {
+                return getValue(name, value);
+            }
+            bool getTypedProperty(const std::string& name, double& value) const override
+            {
+                return getValue(name, value);
+            }
+            bool getTypedProperty(const std::string& name, std::string& value) const override
+            {
+                return getValue(name, value);
+            }
+            bool getTypedProperty(const std::string& name, std::vector<bool>& value) const override
+            {
+                return getArrayValue(name, value);
+            }
+            bool getTypedProperty(const std::string& name, std::vector<int32_t>& value) const override
+            {
+                return getArrayValue(name, value);
+            }
+            bool getTypedProperty(const std::string& name, std::vector<double>& value) const override
+            {
+                return getArrayValue(name, value);
+            }
+            bool getTypedProperty(const std::string& name, std::vector<std::string>& value) const override
+            {
+                return getValue(name, value);
+            }
+
         private:
+            /// the stub calls of the properties, measured by the RPCMetrics
+            int32_t callSetProperty(const std::string& path, const std::string& type, const std::string& value)
+            {
+                RPCCallScope call(_participant_name, "configuration", "setProperty");
+                const int32_t retval = _stub.setProperty(path, type, value);
+                call.addPayload(path.size() + type.size() + value.size());
+                if (retval != 0)
+                {
+                    call.setFailed();
+                }
+                return retval;
+            }
+
+            Json::Value callGetProperty(const std::string& path) const
+            {
+                RPCCallScope call(_participant_name, "configuration", "getProperty");
+                Json::Value property = _stub.getProperty(path);
+                if (call.isEnabled())
+                {
+                    const std::string type = property["type"].asString();
+                    call.addPayload(path.size() + type.size() + property["value"].asString().size());
+                    if (type.empty())
+                    {
+                        call.setFailed();
+                    }
+                }
+                return property;
+            }
+
+            std::string callGetProperties(const std::string& path) const
+            {
+                RPCCallScope call(_participant_name, "configuration", "getProperties");
+                std::string properties = _stub.getProperties(path);
+                call.addPayload(path.size() + properties.size());
+                return properties;
+            }
+
             /**
-            * @brief Check a property path which includes the property name for validity.
-            * Currently only the '/' syntax is considered valid.
-            * '.' syntax is not supported.
-            *
-            * @param property_path the propery path to be checked
-            *
-            * @return bool success boolean
+            * @brief The RPC transports the values as strings, so only the type name is
+            * resolved at compile time here.
             */
-            bool isPropertyPathValid(const std::string& property_path) const
+            template<typename T>
+            bool setValue(const std::string& name, const T& value)
             {
-                return std::regex_match(property_path, _property_path_regex);
+                return setProperty(name, DefaultPropertyTypeConversion<T>::toString(value), PropertyType<T>::getTypeName());
             }
 
             /**
-            * @brief Remove leading and concluding '/' characters a property name.
-            *
-            * @param property_name the propery name to be normalized
+            * @brief Arrays are sent binary encoded to participants supporting it.
+            */
+            template<typename T>
+            bool setArrayValue(const std::string& name, const std::vector<T>& value)
+            {
+                if (_clientsafe_ptr->supportsBinaryArrays())
+                {
+                    return setProperty(name, binary_array::encode(value), binary_array::getTypeName<T>());
+                }
+                return setValue(name, value);
+            }
+
+            /**
+            * @brief Reads type and value of the property with one call.
             *
-            * @return string the normalized property name
+            * @param name name of the property
+            * @param path will contain the full path of the property
+            * @param type will contain the type name
+            * @param value will contain the value
+            * @return false if the property does not exist (logged already)
             */
-            std::string normalizeName(const std::string& property_name) const
+            bool retrieveProperty(const std::string& name, std::string& path, std::string& type, std::string& value) const
             {
-                std::string normalized_name = property_name;
+                if (!resolvePath(name, path))
+                {
+                    fep::Result result(ERR_INVALID_ARG);
+                    FEP_CONFIG_LOG_RESULT(result, _participant_name, _component_name, std::string("getProperty"), path);
+                    return false;
+                }
+                const auto property = callGetProperty(path);
+                type = property["type"].asString();
+                if (type.empty())
+                {
+                    FEP_CONFIG_LOG_RESULT(fep::Result(ERR_PATH_NOT_FOUND), _participant_name, _component_name, std::string("getProperty"), path);
+                    return false;
+                }
+                value = property["value"].asString();
+                return true;
+            }
+
+            /**
+            * @brief Reads type and value with one call and compares the type with the compile time type name.
+            */
+            template<typename T>
+            bool getValue(const std::string& name, T& value) const
+            {
+                std::string path, type, value_string;
+                if (!retrieveProperty(name, path, type, value_string))
+                {
+                    return false;
+                }
+                else if (type != PropertyType<T>::getTypeName())
+                {
+                    FEP_CONFIG_LOG_RESULT(fep::Result(ERR_INVALID_TYPE), _participant_name, _component_name, std::string("getProperty"), path);
+                    return false;
+                }
+                value = DefaultPropertyTypeConversion<T>::fromString(value_string);
+                return true;
+            }
 
-                if (normalized_name.at(0) == '/')
+            /**
+            * @brief Reads the array in the string or the binary encoded representation, whichever the participant delivers.
+            */
+            template<typename T>
+            bool getArrayValue(const std::string& name, std::vector<T>& value) const
+            {
+                std::string path, type, value_string;
+                if (!retrieveProperty(name, path, type, value_string))
+                {
+                    return false;
+                }
+                else if (type == binary_array::getTypeName<T>())
                 {
-                    normalized_name = normalized_name.substr(1, normalized_name.size());
+                    if (binary_array::decode(value_string, value))
+                    {
+                        return true;
+                    }
                 }
-                if (normalized_name.at(normalized_name.size() - 1) == '/')
+                else if (type == PropertyType<std::vector<T>>::getTypeName())
                 {
-                    normalized_name = normalized_name.substr(0, normalized_name.size() - 1);
+                    value = DefaultPropertyTypeConversion<std::vector<T>>::fromString(value_string);
+                    return true;
                 }
+                FEP_CONFIG_LOG_RESULT(fep::Result(ERR_INVALID_TYPE), _participant_name, _component_name, std::string("getProperty"), path);
+                return false;
+            }
 
-                return normalized_name;
+            /**
+            * @brief Resolves the full path of a property within this node.
+            * Only the '/' syntax is considered valid, '.' syntax is not supported.
+            * The name is parsed once, later calls with the same name reuse the interned path.
+            *
+            * @param name the property name, optionally with leading and concluding '/'
+            * @param path will contain the full path (or the unresolved path for logging if invalid)
+            *
+            * @return bool false if the name is no valid property path
+            */
+            bool resolvePath(const std::string& name, std::string& path) const
+            {
+                const auto property_path = PropertyPath::parse(name);
+                if (!property_path.isValid() || !_node_path.isValid())
+                {
+                    path = _property_path + name;
+                    return false;
+                }
+                path = _node_path.append(property_path).toServicePath();
+                return true;
             }
         };
 
@@ -264,32 +492,35 @@ namespace fep
                               std::string rpc_component_name,
                               IRPC& rpc,
                               ISystemLogger& logger,
-                              AutomationInterface* ai_hacky_for_timing_config_check=nullptr) :
+                              AutomationInterface* ai_hacky_for_timing_config_check=nullptr,
+                              std::weak_ptr<PropertyWatcher> watcher = std::weak_ptr<PropertyWatcher>()) :
                               _logger(logger),
                               _ai_hacky_for_timing_config_check(ai_hacky_for_timing_config_check),
                               base_type(participant_name.c_str(), rpc_component_name.c_str(), rpc),
                               _participant_name(participant_name),
-                              _component_name(rpc_component_name)
+                              _component_name(rpc_component_name),
+                              _watcher(std::move(watcher))
             {
             }
 
             std::string normalizePath(const std::string& property_path) const
             {
-                if (property_path == "/" || property_path.empty())
+                const auto path = PropertyPath::parse(property_path);
+                if (path.isRoot())
                 {
                     return "/";
                 }
+                else if (path.isValid())
+                {
+                    return path.toServicePath() + "/";
+                }
+                else if (property_path.at(property_path.size() - 1) == '/')
+                {
+                    return property_path;
+                }
                 else
                 {
-                    if (property_path.at(property_path.size() - 1) == '/')
-                    {
-                        return property_path;
-                    }
-                    else
-                    {
-                        std::string retval = property_path + "/";
-                        return retval;
-                    }
+                    return property_path + "/";
                 }
             }
     
@@ -303,7 +534,7 @@ namespace fep
                 std::shared_ptr<const ConfigurationProxy> ptr = shared_from_this();
                 std::string normalized_path = normalizePath(property_path);
 
-                if (base_type::GetStub().exists(normalized_path))
+                if (callExists(normalized_path))
                 {
                     return std::make_shared<ConfigurationProperty>(ptr,
                         GetStub(),
@@ -328,7 +559,7 @@ namespace fep
                 std::shared_ptr<const ConfigurationProxy> ptr = shared_from_this();
                 std::string normalized_path = normalizePath(property_path);
 
-                if (base_type::GetStub().exists(normalized_path))
+                if (callExists(normalized_path))
                 {
                     return std::make_shared<ConfigurationProperty>(shared_from_this(),
                         GetStub(),
@@ -344,28 +575,78 @@ namespace fep
                 }
             }
 
+            void registerPropertyListener(const std::string& property_path, rpc::IPropertyChangeListener& listener) override
+            {
+                auto watcher = _watcher.lock();
+                if (!watcher)
+                {
+                    FEP_CONFIG_LOG_AND_THROW_RESULT(fep::Result(ERR_NOT_CONNECTED), _participant_name, _component_name, std::string("registerPropertyListener"), property_path);
+                }
+                watcher->registerListener(property_path, listener);
+            }
+
+            void unregisterPropertyListener(const std::string& property_path, rpc::IPropertyChangeListener& listener) override
+            {
+                auto watcher = _watcher.lock();
+                if (watcher)
+                {
+                    watcher->unregisterListener(property_path, listener);
+                }
+            }
+
         private:
+            /**
+             * @brief Checks once per participant whether its configuration service supports
+             * binary encoded arrays (see binary_array::capability_path).
+             */
+            bool supportsBinaryArrays() const
+            {
+                std::lock_guard<std::mutex> lock(_binary_arrays_mutex);
+                if (!_binary_arrays_checked)
+                {
+                    RPCCallScope call(_participant_name, "configuration", "getProperty");
+                    const auto capability = base_type::GetStub().getProperty(binary_array::capability_path);
+                    _supports_binary_arrays = capability["type"].asString() == PropertyType<bool>::getTypeName()
+                        && DefaultPropertyTypeConversion<bool>::fromString(capability["value"].asString());
+                    _binary_arrays_checked = true;
+                }
+                return _supports_binary_arrays;
+            }
+
+            bool callExists(const std::string& path) const
+            {
+                RPCCallScope call(_participant_name, "configuration", "exists");
+                call.addPayload(path.size());
+                return base_type::GetStub().exists(path);
+            }
+
             ISystemLogger&                    _logger;
             std::string                       _participant_name;
             std::string                       _component_name;
             AutomationInterface*              _ai_hacky_for_timing_config_check;
+            mutable std::mutex                _binary_arrays_mutex;
+            mutable bool                      _binary_arrays_checked = false;
+            mutable bool                      _supports_binary_arrays = false;
+            std::weak_ptr<PropertyWatcher>    _watcher;
     };
 
     class ConfigurationProxyOldSql : public IRPCObjectClient, public rpc::IRPCConfiguration
     {
-        class ConnectionInterfaceProperty : public IProperties
+        class ConnectionInterfaceProperty : public IProperties, public ITypedProperties, public ICachedProperties, public IPropertyTreeReader
         {
             public:
                 ConnectionInterfaceProperty(std::string participant_name,
                     std::string component_name,
                     std::string currentpath,
                     timestamp_t timeout,
-                    ISystemLogger& logger) :
+                    ISystemLogger& logger,
+                    std::unique_ptr<IProperty> retrieved_node = nullptr) :
                     _participant_name(std::move(participant_name)),
                     _component_name(std::move(component_name)),
                     _current_path(std::move(currentpath)),
                     _timeout(timeout),
-                    _logger(logger)
+                    _logger(logger),
+                    _node(std::move(retrieved_node))
                 {
                 }
                 virtual ~ConnectionInterfaceProperty() = default;
@@ -391,14 +672,14 @@ namespace fep
                         }
                         else
                         {
-                            _logger.log(logging::CATEGORY_COMPONENT, logging::SEVERITY_WARNING, _participant_name,
+                            _logger.logLazy(logging::CATEGORY_COMPONENT, logging::SEVERITY_WARNING, _participant_name,
                                 _component_name,
-                                a_util::strings::format("Can not %s '%s' due following error : (%d - %s)  ",
+                                [&]() { return a_util::strings::format("Can not %s '%s' due following error : (%d - %s)  ",
                                     method.c_str(),
                                     path.c_str(),
                                     res.getErrorCode(),
                                     res.getErrorLabel(),
-                                    res.getDescription()));
+                                    res.getDescription()); });
                         }
                         return false;
                     }
@@ -409,92 +690,378 @@ namespace fep
                     {
                         return path;
                     }
+                    else if (path.empty())
+                    {
+                        return _current_path;
+                    }
                     else
                     {
                         return _current_path + "." + path;
                     }
                 }
+
+                /**
+                 * @brief returns the subtree of this node, it is retrieved once and kept until refresh
+                 *
+                 * @return the subtree or nullptr if it can not be retrieved
+                 */
+                std::shared_ptr<const IProperty> getNode() const
+                {
+                    std::lock_guard<std::mutex> lock(_node_mutex);
+                    if (!_node)
+                    {
+                        std::unique_ptr<IProperty> retrieved_node;
+                        RPCCallScope call(_participant_name, "automation_interface", "GetProperty");
+                        if (fep::isOk(_coin.getAI().GetProperty(_current_path, retrieved_node, _participant_name, _timeout)))
+                        {
+                            _node = std::move(retrieved_node);
+                        }
+                        else
+                        {
+                            call.setFailed();
+                        }
+                    }
+                    return _node;
+                }
+
+                static const IProperty* findSubProperty(const IProperty& node, const std::string& name)
+                {
+                    const IProperty* current = &node;
+                    for (const auto& name_part : a_util::strings::split(name, "."))
+                    {
+                        const IProperty* found = nullptr;
+                        for (const auto& sub_prop : current->GetSubProperties())
+                        {
+                            if (name_part == sub_prop->GetName())
+                            {
+                                found = sub_prop;
+                                break;
+                            }
+                        }
+                        if (!found)
+                        {
+                            return nullptr;
+                        }
+                        current = found;
+                    }
+                    return current;
+                }
+
+                /**
+                 * @brief resolves the property within the cached subtree of this node.
+                 * Properties which are not contained (e.g. created after the subtree was retrieved)
+                 * are requested from the participant.
+                 *
+                 * @param name name of the property relative to this node, empty for the node itself
+                 * @param property will contain the property (sharing the ownership of the subtree)
+                 * @return the result of the request
+                 */
+                fep::Result retrieveProperty(const std::string& name, std::shared_ptr<const IProperty>& property) const
+                {
+                    auto node = getNode();
+                    if (node)
+                    {
+                        const IProperty* found = findSubProperty(*node, name);
+                        if (found)
+                        {
+                            property = std::shared_ptr<const IProperty>(node, found);
+                            return ERR_NOERROR;
+                        }
+                    }
+                    std::unique_ptr<IProperty> retrieved_property;
+                    RPCCallScope call(_participant_name, "automation_interface", "GetProperty");
+                    auto res = _coin.getAI().GetProperty(addPath(name), retrieved_property, _participant_name, _timeout);
+                    if (fep::isOk(res))
+                    {
+                        property = std::move(retrieved_property);
+                    }
+                    else
+                    {
+                        call.setFailed();
+                    }
+                    return res;
+                }
+                template<typename T>
+                bool setValue(const std::string& name, const T& value)
+                {
+                    std::string path = addPath(name);
+                    TraceScope trace("participant", "write property", _participant_name, path);
+                    fep::Result res;
+                    {
+                        RPCCallScope call(_participant_name, "automation_interface", "SetPropertyValue");
+                        res = _coin.getAI().SetPropertyValue(path,
+                            value,
+                            _participant_name,
+                            _timeout);
+                        if (fep::isFailed(res))
+                        {
+                            call.setFailed();
+                        }
+                    }
+                    refresh();
+                    return checkResult("setProperty", path, res);
+                }
+
+                template<typename T>
+                bool setValue(const std::string& name, const std::vector<T>& value)
+                {
+                    std::string path = addPath(name);
+                    TraceScope trace("participant", "write property", _participant_name, path);
+                    fep::Result res;
+                    {
+                        RPCCallScope call(_participant_name, "automation_interface", "SetPropertyValues");
+                        res = _coin.getAI().SetPropertyValues(path,
+                            value,
+                            _participant_name,
+                            _timeout);
+                        if (fep::isFailed(res))
+                        {
+                            call.setFailed();
+                        }
+                    }
+                    refresh();
+                    return checkResult("setProperty", path, res);
+                }
+
+                static bool isOfType(const IProperty& property, const bool&)
+                {
+                    return property.IsBoolean();
+                }
+                static bool isOfType(const IProperty& property, const int32_t&)
+                {
+                    return property.IsInteger();
+                }
+                static bool isOfType(const IProperty& property, const double&)
+                {
+                    return property.IsFloat();
+                }
+                static bool isOfType(const IProperty& property, const std::string&)
+                {
+                    return property.IsString();
+                }
+
+                template<typename T>
+                static void readElement(const IProperty& property, T& value, size_t idx)
+                {
+                    property.GetValue(value, idx);
+                }
+                static void readElement(const IProperty& property, std::string& value, size_t idx)
+                {
+                    const char* current_val = nullptr;
+                    property.GetValue(current_val, idx);
+                    value = current_val ? current_val : "";
+                }
+
+                /**
+                 * @brief reads the value without any string conversion
+                 * @return false if the property is an array or not of type T
+                 */
+                template<typename T>
+                static bool readValue(const IProperty& property, T& value)
+                {
+                    if (property.IsArray() || !isOfType(property, value))
+                    {
+                        return false;
+                    }
+                    readElement(property, value, 0);
+                    return true;
+                }
+
+                /**
+                 * @brief reads the array value without any string conversion
+                 * @return false if the property is no array or not of type T
+                 */
+                template<typename T>
+                static bool readValue(const IProperty& property, std::vector<T>& value)
+                {
+                    if (!property.IsArray() || !isOfType(property, T()))
+                    {
+                        return false;
+                    }
+                    std::vector<T> value_array;
+                    size_t arr_size = property.GetArraySize();
+                    value_array.reserve(arr_size);
+                    for (size_t idx = 0;
+                        idx < arr_size;
+                        idx++)
+                    {
+                        T current_val;
+                        readElement(property, current_val, idx);
+                        value_array.push_back(current_val);
+                    }
+                    value.swap(value_array);
+                    return true;
+                }
+
+                template<typename T>
+                bool getValue(const std::string& name, T& value) const
+                {
+                    std::string path = addPath(name);
+                    std::shared_ptr<const IProperty> retrieved_property;
+                    auto res = retrieveProperty(name, retrieved_property);
+                    if (fep::isFailed(res))
+                    {
+                        checkResult("getProperty", path, res);
+                        return false;
+                    }
+                    else if (!readValue(*retrieved_property, value))
+                    {
+                        checkResult("getProperty", path, ERR_INVALID_TYPE);
+                        return false;
+                    }
+                    return true;
+                }
+
             public:
                 bool setProperty(const std::string& name,
                                  const std::string& value,
                                  const std::string& type) override
                 {
-                    std::string path = addPath(name);
                     if (type == PropertyType<bool>::getTypeName())
                     {
-                        auto res = _coin.getAI().SetPropertyValue(path,
-                            DefaultPropertyTypeConversion<bool>::fromString(value),
-                            _participant_name,
-                            _timeout);
-                        return checkResult("setProperty", path, res);
+                        return setValue(name, DefaultPropertyTypeConversion<bool>::fromString(value));
                     }
                     else if (type == PropertyType<int32_t>::getTypeName())
                     {
-                        auto res = _coin.getAI().SetPropertyValue(path,
-                            DefaultPropertyTypeConversion<int32_t>::fromString(value),
-                            _participant_name,
-                            _timeout);
-                        return checkResult("setProperty", path, res);
+                        return setValue(name, DefaultPropertyTypeConversion<int32_t>::fromString(value));
                     }
                     else if (type == PropertyType<double>::getTypeName())
                     {
-                        auto res = _coin.getAI().SetPropertyValue(path,
-                            DefaultPropertyTypeConversion<double>::fromString(value),
-                            _participant_name,
-                            _timeout);
-                        return checkResult("setProperty", path, res);
+                        return setValue(name, DefaultPropertyTypeConversion<double>::fromString(value));
                     }
                     else if (type == PropertyType<std::string>::getTypeName())
                     {
-                        auto res = _coin.getAI().SetPropertyValue(path,
-                            DefaultPropertyTypeConversion<std::string>::fromString(value),
-                            _participant_name,
-                            _timeout);
-                        return checkResult("setProperty", path, res);
+                        return setValue(name, DefaultPropertyTypeConversion<std::string>::fromString(value));
                     }
                     else if (type == PropertyType<std::vector<bool>>::getTypeName())
                     {
-                        std::vector<bool> vector_value = DefaultPropertyTypeConversion<std::vector<bool>>::fromString(value);
-                        auto res = _coin.getAI().SetPropertyValues(path,
-                            vector_value,
-                            _participant_name,
-                            _timeout);
-                         return checkResult("setProperty", path, res);
+                        return setValue(name, DefaultPropertyTypeConversion<std::vector<bool>>::fromString(value));
                     }
                     else if (type == PropertyType<std::vector<int32_t>>::getTypeName())
                     {
-                        std::vector<int32_t> vector_value = DefaultPropertyTypeConversion<std::vector<int32_t>>::fromString(value);
-                        auto res = _coin.getAI().SetPropertyValues(path,
-                            vector_value,
-                            _participant_name,
-                            _timeout);
-                        return checkResult("setProperty", path, res);
+                        return setValue(name, DefaultPropertyTypeConversion<std::vector<int32_t>>::fromString(value));
                     }
                     else if (type == PropertyType<std::vector<double>>::getTypeName())
                     {
-                        std::vector<double> vector_value = DefaultPropertyTypeConversion<std::vector<double>>::fromString(value);
-                        auto res = _coin.getAI().SetPropertyValues(path,
-                            vector_value,
-                            _participant_name,
-                            _timeout);
-                        return checkResult("setProperty", path, res);
+                        return setValue(name, DefaultPropertyTypeConversion<std::vector<double>>::fromString(value));
                     }
                     else if (type == PropertyType<std::vector<std::string>>::getTypeName())
                     {
-                        std::vector<std::string> vector_value = DefaultPropertyTypeConversion<std::vector<std::string>>::fromString(value);
-                        auto res = _coin.getAI().SetPropertyValues(path,
-                            vector_value,
-                            _participant_name,
-                            _timeout);
-                        return checkResult("setProperty", path, res);
+                        return setValue(name, DefaultPropertyTypeConversion<std::vector<std::string>>::fromString(value));
                     }
                     else
                     {
+                        std::string path = addPath(name);
                         return checkResult("setProperty", path, ERR_INVALID_TYPE);
                     }
                 }
 
-                template<typename T> std::string getPropertyValueAsString(const std::unique_ptr<IProperty>& property_val) const
+                bool setTypedProperty(const std::string& name, bool value) override
+                {
+                    return setValue(name, value);
+                }
+                bool setTypedProperty(const std::string& name, int32_t value) override
+                {
+                    return setValue(name, value);
+                }
+                bool setTypedProperty(const std::string& name, double value) override
+                {
+                    return setValue(name, value);
+                }
+                bool setTypedProperty(const std::string& name, const std::string& value) override
+                {
+                    return setValue(name, value);
+                }
+                bool setTypedProperty(const std::string& name, const std::vector<bool>& value) override
+                {
+                    return setValue(name, value);
+                }
+                bool setTypedProperty(const std::string& name, const std::vector<int32_t>& value) override
+                {
+                    return setValue(name, value);
+                }
+                bool setTypedProperty(const std::string& name, const std::vector<double>& value) override
+                {
+                    return setValue(name, value);
+                }
+                bool setTypedProperty(const std::string& name, const std::vector<std::string>& value) override
+                {
+                    return setValue(name, value);
+                }
+
+                /**
+                 * @brief reads all properties of the retrieved subtree, so only one request is sent
+                 */
+                void readTree(ParticipantConfiguration& values) const override
+                {
+                    auto node = getNode();
+                    if (!node)
+                    {
+                        std::string path = _current_path;
+                        checkResult("readTree", path, ERR_PATH_NOT_FOUND);
+                        return;
+                    }
+                    readTree(*node, std::string(), values);
+                }
+
+                void readTree(const IProperty& node, const std::string& prefix, ParticipantConfiguration& values) const
+                {
+                    for (const auto& sub_prop : node.GetSubProperties())
+                    {
+                        const std::string name = prefix.empty() ? sub_prop->GetName() : prefix + "." + sub_prop->GetName();
+                        if (sub_prop->IsBoolean() || sub_prop->IsInteger() || sub_prop->IsFloat() || sub_prop->IsString())
+                        {
+                            std::string path = name;
+                            std::replace(path.begin(), path.end(), '.', '/');
+                            values[path] = { getProperty(name), getPropertyType(name) };
+                        }
+                        readTree(*sub_prop, name, values);
+                    }
+                }
+
+                /**
+                 * @brief drops the retrieved subtree, the next read will retrieve it again
+                 */
+                void refresh() const override
+                {
+                    std::lock_guard<std::mutex> lock(_node_mutex);
+                    _node.reset();
+                }
+
+                bool getTypedProperty(const std::string& name, bool& value) const override
+                {
+                    return getValue(name, value);
+                }
+                bool getTypedProperty(const std::string& name, int32_t& value) const override
+                {
+                    return getValue(name, value);
+                }
+                bool getTypedProperty(const std::string& name, double& value) const override
+                {
+                    return getValue(name, value);
+                }
+                bool getTypedProperty(const std::string& name, std::string& value) const override
+                {
+                    return getValue(name, value);
+                }
+                bool getTypedProperty(const std::string& name, std::vector<bool>& value) const override
+                {
+                    return getValue(name, value);
+                }
+                bool getTypedProperty(const std::string& name, std::vector<int32_t>& value) const override
+                {
+                    return getValue(name, value);
+                }
+                bool getTypedProperty(const std::string& name, std::vector<double>& value) const override
+                {
+                    return getValue(name, value);
+                }
+                bool getTypedProperty(const std::string& name, std::vector<std::string>& value) const override
+                {
+                    return getValue(name, value);
+                }
+
+                template<typename T> std::string getPropertyValueAsString(const std::shared_ptr<const IProperty>& property_val) const
                 {
                     T value;
                     property_val->GetValue(value);
@@ -502,7 +1069,7 @@ namespace fep
                 }
 
                 template<typename T>
-                std::string getArrayPropertyValueAsString(const std::unique_ptr<IProperty>& property_val) const
+                std::string getArrayPropertyValueAsString(const std::shared_ptr<const IProperty>& property_val) const
                 {
                     std::vector<T> value_array;
                     size_t arr_size = property_val->GetArraySize();
@@ -521,8 +1088,8 @@ namespace fep
                 std::string getProperty(const std::string& name) const override
                 {
                     std::string path = addPath(name);
-                    std::unique_ptr<IProperty> retrieved_property;
-                    auto res = _coin.getAI().GetProperty(path, retrieved_property, _participant_name, _timeout);
+                    std::shared_ptr<const IProperty> retrieved_property;
+                    auto res = retrieveProperty(name, retrieved_property);
                     if (fep::isFailed(res))
                     {
                         checkResult("getProperty", path, res);
@@ -602,8 +1169,8 @@ namespace fep
                 std::string getPropertyType(const std::string& name) const override
                 {
                     std::string path = addPath(name);
-                    std::unique_ptr<IProperty> retrieved_property;
-                    auto res = _coin.getAI().GetProperty(path, retrieved_property, _participant_name, _timeout);
+                    std::shared_ptr<const IProperty> retrieved_property;
+                    auto res = retrieveProperty(name, retrieved_property);
                     if (fep::isFailed(res))
                     {
                         checkResult("getPropertyType", path, res);
@@ -712,8 +1279,8 @@ namespace fep
                     std::string path = _current_path;
                     
                     std::vector<std::string> ret_val;
-                    std::unique_ptr<IProperty> retrieved_property;
-                    auto res = _coin.getAI().GetProperty(path, retrieved_property, _participant_name, _timeout);
+                    std::shared_ptr<const IProperty> retrieved_property;
+                    auto res = retrieveProperty(std::string(), retrieved_property);
                     if (fep::isFailed(res))
                     {
                         checkResult("getPropertyNames", path, res);
@@ -736,17 +1303,21 @@ namespace fep
                 std::string _current_path;
                 timestamp_t _timeout;
                 ISystemLogger& _logger;
+                mutable std::mutex _node_mutex;
+                mutable std::shared_ptr<const IProperty> _node;
         };
 
         public:
             ConfigurationProxyOldSql(std::string participant_name,
                 ISystemLogger& logger,
                 std::string rpc_component_name,
-                timestamp_t timeout) :
+                timestamp_t timeout,
+                std::weak_ptr<PropertyWatcher> watcher = std::weak_ptr<PropertyWatcher>()) :
                     _participant_name(std::move(participant_name)),
                     _logger(logger),
                     _component_name(std::move(rpc_component_name)),
-                    _timeout(timeout)
+                    _timeout(timeout),
+                    _watcher(std::move(watcher))
             {
             }
             std::string getRPCObjectIID() const override
@@ -790,6 +1361,7 @@ namespace fep
                 std::unique_ptr<fep::IProperty> retrieved_property;
                 std::string normalized_path = normalizePath(property_path);
                 
+                RPCCallScope call(_participant_name, "automation_interface", "GetProperty");
                 auto res = _coin.getAI().GetProperty(normalized_path, retrieved_property, _participant_name, _timeout);
                 if (fep::isOk(res) && retrieved_property.get() != nullptr)
                 {
@@ -797,10 +1369,12 @@ namespace fep
                                                                          _component_name,
                                                                          normalized_path,
                                                                          _timeout,
-                                                                         _logger);
+                                                                         _logger,
+                                                                         std::move(retrieved_property));
                 }
                 else
                 {
+                    call.setFailed();
                     FEP_CONFIG_LOG_AND_THROW_RESULT(res, _participant_name, _component_name, std::string("getProperties"), property_path);
                 }
             }
@@ -814,6 +1388,7 @@ namespace fep
                 std::unique_ptr<fep::IProperty> retrieved_property;
                 std::string normalized_path = normalizePath(property_path);
 
+                RPCCallScope call(_participant_name, "automation_interface", "GetProperty");
                 auto res = _coin.getAI().GetProperty(normalized_path, retrieved_property, _participant_name, _timeout);
                 if (fep::isOk(res) && retrieved_property.get() != nullptr)
                 {
@@ -821,13 +1396,34 @@ namespace fep
                         _component_name,
                         normalized_path,
                         _timeout,
-                        _logger);
+                        _logger,
+                        std::move(retrieved_property));
                 }
                 else
                 {
+                    call.setFailed();
                     FEP_CONFIG_LOG_AND_THROW_RESULT(res, _participant_name, _component_name, std::string("getProperties"), property_path);
                 }
             }
+
+            void registerPropertyListener(const std::string& property_path, rpc::IPropertyChangeListener& listener) override
+            {
+                auto watcher = _watcher.lock();
+                if (!watcher)
+                {
+                    FEP_CONFIG_LOG_AND_THROW_RESULT(fep::Result(ERR_NOT_CONNECTED), _participant_name, _component_name, std::string("registerPropertyListener"), property_path);
+                }
+                watcher->registerListener(property_path, listener);
+            }
+
+            void unregisterPropertyListener(const std::string& property_path, rpc::IPropertyChangeListener& listener) override
+            {
+                auto watcher = _watcher.lock();
+                if (watcher)
+                {
+                    watcher->unregisterListener(property_path, listener);
+                }
+            }
         private:
             std::string _participant_name;
             std::string _component_name;
@@ -835,6 +1431,7 @@ namespace fep
             ConnectionInterface _coin;
             ISystemLogger& _logger;
             timestamp_t  _timeout;
+            std::weak_ptr<PropertyWatcher> _watcher;
     };
 }
 
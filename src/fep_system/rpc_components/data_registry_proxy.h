@@ -24,6 +24,7 @@ You may add additional accurate notices of copyright ownership.
 #include "rpc_components/data_registry/data_registry_rpc_intf.h"
 #include <fep_system_stubs/data_registry_proxy_stub.h>
 #include "system_logger_intf.h"
+#include "rpc_metrics.h"
 #ifdef SEVERITY_ERROR
 #undef SEVERITY_ERROR
 #endif
@@ -41,14 +42,17 @@ namespace fep
         DataRegistryProxy(std::string participant_name,
                           std::string rpc_component_name,
                           IRPC& rpc) :
-                          base_type(participant_name.c_str(), rpc_component_name.c_str(), rpc)
+                          base_type(participant_name.c_str(), rpc_component_name.c_str(), rpc),
+                          _participant_name(participant_name)
         {
         }
         std::vector<std::string> getSignalsIn() const override
         {
             try
             {
+                RPCCallScope call(_participant_name, "data_registry", "getSignalsIn");
                 std::string signal_list = GetStub().getSignalsIn();
+                call.addPayload(signal_list.size());
                 return detail::string_to_stringlist(signal_list);
             }
             catch (...)
@@ -60,7 +64,9 @@ namespace fep
         {
             try
             {
+                RPCCallScope call(_participant_name, "data_registry", "getSignalsOut");
                 std::string signal_list = GetStub().getSignalsOut();
+                call.addPayload(signal_list.size());
                 return detail::string_to_stringlist(signal_list);
             }
             catch (...)
@@ -73,6 +79,8 @@ namespace fep
             return StreamType(StreamMetaType("hook"));
         }
 
+    private:
+        const std::string _participant_name;
     };
 
     class DataRegistryProxyOldSql : public IRPCObjectClient, public rpc::IRPCDataRegistry
@@ -86,8 +94,10 @@ namespace fep
         std::vector<fep::cUserSignalOptions> getSignals() const
         {
             std::vector<fep::cUserSignalOptions> signals;
+            RPCCallScope call(_participant_name, "automation_interface", "GetParticipantSignals");
             if (isFailed(_coin.getAI().GetParticipantSignals(signals, _participant_name)))
             {
+                call.setFailed();
                 _logger.log(logging::CATEGORY_COMPONENT, logging::SEVERITY_ERROR, _participant_name, 
                     "DataRegistry", "Participant does not respond during the given timeout");
                 throw std::runtime_error{ "Couldn't determine signals of the following participant: " + _participant_name };
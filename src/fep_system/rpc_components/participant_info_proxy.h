@@ -25,6 +25,7 @@ You may add additional accurate notices of copyright ownership.
 
 #include "rpc_components/participant_info/participant_info_rpc_intf.h"
 #include "connection_interface.h"
+#include "rpc_metrics.h"
 
 namespace fep
 {
@@ -39,7 +40,8 @@ namespace fep
         ParticipantInfoProxy(std::string participant_name,
                              std::string rpc_component_name,
                              IRPC& rpc) :
-                             base_type(participant_name.c_str(), rpc_component_name.c_str(), rpc)
+                             base_type(participant_name.c_str(), rpc_component_name.c_str(), rpc),
+                             _participant_name(participant_name)
         {
         }
 
@@ -47,7 +49,10 @@ namespace fep
         {
             try
             {
-                return GetStub().getName();
+                RPCCallScope call(_participant_name, "participant_info", "getName");
+                std::string name = GetStub().getName();
+                call.addPayload(name.size());
+                return name;
             }
             catch (...)
             {
@@ -58,7 +63,10 @@ namespace fep
         {
             try
             {
-                return GetStub().getSystemName();
+                RPCCallScope call(_participant_name, "participant_info", "getSystemName");
+                std::string system_name = GetStub().getSystemName();
+                call.addPayload(system_name.size());
+                return system_name;
             }
             catch (...)
             {
@@ -70,7 +78,9 @@ namespace fep
         {
             try
             {
+                RPCCallScope call(_participant_name, "participant_info", "getRPCComponents");
                 std::string list = GetStub().getRPCComponents();
+                call.addPayload(list.size());
                 return detail::string_to_stringlist(list);
             }
             catch (...)
@@ -82,7 +92,9 @@ namespace fep
         {
             try
             {
+                RPCCallScope call(_participant_name, "participant_info", "getRPCComponentIIDs");
                 std::string list = GetStub().getRPCComponentIIDs(rpc_component_name);
+                call.addPayload(rpc_component_name.size() + list.size());
                 return detail::string_to_stringlist(list);
             }
             catch (...)
@@ -95,7 +107,10 @@ namespace fep
         {
             try
             {
-                return GetStub().getRPCComponenttInterfaceDefinition(rpc_component_name, rpc_component_iid);
+                RPCCallScope call(_participant_name, "participant_info", "getRPCComponentInterfaceDefinition");
+                std::string definition = GetStub().getRPCComponenttInterfaceDefinition(rpc_component_name, rpc_component_iid);
+                call.addPayload(rpc_component_name.size() + rpc_component_iid.size() + definition.size());
+                return definition;
             }
             catch (...)
             {
@@ -103,6 +118,8 @@ namespace fep
             }
         }
 
+    private:
+        const std::string _participant_name;
     };
 
     class ParticipantInfoProxyOldSql : public IRPCObjectClient, public rpc::IRPCParticipantInfo
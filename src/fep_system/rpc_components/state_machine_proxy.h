@@ -23,6 +23,7 @@ You may add additional accurate notices of copyright ownership.
 #include <fep_system_stubs/state_machine_proxy_stub.h>
 
 #include "rpc_components/legacy/state_machine/state_machine_rpc_intf.h"
+#include "rpc_metrics.h"
 
 namespace fep
 {
@@ -37,7 +38,8 @@ namespace fep
         StateMachineProxy(std::string participant_name,
                           std::string rpc_component_name,
                           IRPC& rpc) :
-                          base_type(participant_name.c_str(), rpc_component_name.c_str(), rpc)
+                          base_type(participant_name.c_str(), rpc_component_name.c_str(), rpc),
+                          _participant_name(participant_name)
         {
         }
 
@@ -45,6 +47,7 @@ namespace fep
         {
             try
             {
+                RPCCallScope call(_participant_name, "state_machine", "getState");
                 int val = GetStub().getState();
                 rpc::IRPCStateMachine::State state = static_cast<rpc::IRPCStateMachine::State>(val);
                 return state;
@@ -56,6 +59,7 @@ namespace fep
         }
         void initialize() override
         {
+            RPCCallScope call(_participant_name, "state_machine", "initialize");
             if (!GetStub().initialize())
             {
                 throw std::logic_error("state machine intialize denied");
@@ -63,6 +67,7 @@ namespace fep
         }
         void start() override
         {
+            RPCCallScope call(_participant_name, "state_machine", "start");
             if (!GetStub().start())
             {
                 throw std::logic_error("state machine start denied");
@@ -70,6 +75,7 @@ namespace fep
         }
         void stop() override
         {
+            RPCCallScope call(_participant_name, "state_machine", "stop");
             if (!GetStub().initialize())
             {
                 throw std::logic_error("state machine initialize denied");
@@ -77,6 +83,7 @@ namespace fep
         }
         void shutdown() override
         {
+            RPCCallScope call(_participant_name, "state_machine", "shutdown");
             if (!GetStub().shutdown())
             {
                 throw std::logic_error("state machine shutdown denied");
@@ -84,11 +91,15 @@ namespace fep
         }
         void restart() override
         {
+            RPCCallScope call(_participant_name, "state_machine", "restart");
             if (!GetStub().restart())
             {
                 throw std::logic_error("state machine restart denied");
             }
         }
+
+    private:
+        const std::string _participant_name;
     };
 
     class StateMachineProxyOldSql : public IRPCObjectClient, public rpc::IRPCStateMachine
@@ -99,6 +110,18 @@ namespace fep
         ConnectionInterface _coin;
         ISystemLogger& _logger;
 
+        void triggerEvent(tControlEvent event) const
+        {
+            RPCCallScope call(_participant_name, "automation_interface", "TriggerEvent");
+            if (isFailed(_coin.getAI().TriggerEvent(event, _participant_name)))
+            {
+                call.setFailed();
+                _logger.log(logging::CATEGORY_COMPONENT, logging::SEVERITY_FATAL, _participant_name, "IRPCStateMachine",
+                    "Couldn't trigger the following participant: " + _participant_name);
+                throw std::runtime_error{ "Couldn't trigger the following participant: " + _participant_name };
+            }
+        }
+
     public:
         StateMachineProxyOldSql(std::string participant_name, ISystemLogger& logger,
             std::string rpc_component_name) :
@@ -119,13 +142,16 @@ namespace fep
         State getState() const override
         {
             State state;
+            RPCCallScope call(_participant_name, "automation_interface", "GetParticipantState");
             auto res = _coin.getAI().GetParticipantState(state, _participant_name);
             if (res == ERR_TIMEOUT)
             {
+                call.setFailed();
                 return FS_SHUTDOWN;
             }
             else if (isFailed(res))
             {
+                call.setFailed();
                 _logger.log(logging::CATEGORY_COMPONENT, logging::SEVERITY_FATAL, _participant_name, "IRPCStateMachine",
                     "Couldn't determine the state of the following participant: " + _participant_name);
                 throw std::runtime_error{ "Couldn't determine the state of the following participant: " + _participant_name };
@@ -134,48 +160,23 @@ namespace fep
         }
         void initialize() override
         {
-            if (isFailed(_coin.getAI().TriggerEvent(CE_Initialize, _participant_name)))
-            {
-                _logger.log(logging::CATEGORY_COMPONENT, logging::SEVERITY_FATAL, _participant_name, "IRPCStateMachine",
-                    "Couldn't trigger the following participant: " + _participant_name);
-                throw std::runtime_error{ "Couldn't trigger the following participant: " + _participant_name };
-            }
+            triggerEvent(CE_Initialize);
         }
         void start() override
         {
-            if (isFailed(_coin.getAI().TriggerEvent(CE_Start, _participant_name)))
-            {
-                _logger.log(logging::CATEGORY_COMPONENT, logging::SEVERITY_FATAL, _participant_name, "IRPCStateMachine",
-                    "Couldn't trigger the following participant: " + _participant_name);
-                throw std::runtime_error{ "Couldn't trigger the following participant: " + _participant_name };
-            }
+            triggerEvent(CE_Start);
         }
         void stop() override
         {
-            if (isFailed(_coin.getAI().TriggerEvent(CE_Stop, _participant_name)))
-            {
-                _logger.log(logging::CATEGORY_COMPONENT, logging::SEVERITY_FATAL, _participant_name, "IRPCStateMachine",
-                    "Couldn't trigger the following participant: " + _participant_name);
-                throw std::runtime_error{ "Couldn't trigger the following participant: " + _participant_name };
-            }
+            triggerEvent(CE_Stop);
         }
         void shutdown() override
         {
-            if (isFailed(_coin.getAI().TriggerEvent(CE_Shutdown, _participant_name)))
-            {
-                _logger.log(logging::CATEGORY_COMPONENT, logging::SEVERITY_FATAL, _participant_name, "IRPCStateMachine",
-                    "Couldn't trigger the following participant: " + _participant_name);
-                throw std::runtime_error{ "Couldn't trigger the following participant: " + _participant_name };
-            }
+            triggerEvent(CE_Shutdown);
         }
         void restart() override
         {
-            if (isFailed(_coin.getAI().TriggerEvent(CE_Restart, _participant_name)))
-            {
-                _logger.log(logging::CATEGORY_COMPONENT, logging::SEVERITY_FATAL, _participant_name, "IRPCStateMachine",
-                    "Couldn't trigger the following participant: " + _participant_name);
-                throw std::runtime_error{ "Couldn't trigger the following participant: " + _participant_name };
-            }
+            triggerEvent(CE_Restart);
         }
     };
 }
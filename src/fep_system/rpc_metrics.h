@@ -0,0 +1,220 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <algorithm>
+
+#include "fep_system/fep_system.h"
+
+namespace fep
+{
+    /**
+     * @brief Counts the RPC and automation interface calls of this process per participant, component and method.
+     *
+     * Disabled by default, a disabled call costs one relaxed atomic load.
+     * Latencies are counted in buckets of powers of two microseconds, the percentiles are the bucket upper bounds.
+     */
+    class RPCMetrics
+    {
+    public:
+        static RPCMetrics& get()
+        {
+            static RPCMetrics metrics;
+            return metrics;
+        }
+
+        /// the participant name of calls addressing several participants
+        static const std::string& getAnyParticipant()
+        {
+            static const std::string any_participant("*");
+            return any_participant;
+        }
+
+        bool isEnabled() const
+        {
+            return _enabled.load(std::memory_order_relaxed);
+        }
+
+        void setEnabled(bool enabled)
+        {
+            _enabled.store(enabled, std::memory_order_relaxed);
+        }
+
+        void record(const std::string& participant_name,
+                    const char* component,
+                    const char* method,
+                    timestamp_t latency_us,
+                    bool failed,
+                    size_t payload_bytes)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto& calls = _calls[std::make_tuple(participant_name, std::string(component), std::string(method))];
+            ++calls.call_count;
+            if (failed)
+            {
+                ++calls.error_count;
+            }
+            calls.payload_bytes += payload_bytes;
+            calls.total_time += latency_us;
+            calls.max_time = std::max(calls.max_time, latency_us);
+            ++calls.buckets[getBucket(latency_us)];
+        }
+
+        std::vector<RPCCallMetrics> getMetrics() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::vector<RPCCallMetrics> metrics;
+            metrics.reserve(_calls.size());
+            for (const auto& calls : _calls)
+            {
+                RPCCallMetrics current;
+                current.participant_name = std::get<0>(calls.first);
+                current.component = std::get<1>(calls.first);
+                current.method = std::get<2>(calls.first);
+                current.call_count = calls.second.call_count;
+                current.error_count = calls.second.error_count;
+                current.payload_bytes = calls.second.payload_bytes;
+                current.total_time = calls.second.total_time;
+                current.max_time = calls.second.max_time;
+                current.latency_histogram.assign(calls.second.buckets, calls.second.buckets + FEP_SYSTEM_RPC_LATENCY_BUCKETS);
+                current.p50 = getPercentile(calls.second, 50);
+                current.p95 = getPercentile(calls.second, 95);
+                current.p99 = getPercentile(calls.second, 99);
+                metrics.push_back(std::move(current));
+            }
+            return metrics;
+        }
+
+        void reset()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _calls.clear();
+        }
+
+    private:
+        struct Calls
+        {
+            uint64_t call_count = 0;
+            uint64_t error_count = 0;
+            uint64_t payload_bytes = 0;
+            timestamp_t total_time = 0;
+            timestamp_t max_time = 0;
+            uint64_t buckets[FEP_SYSTEM_RPC_LATENCY_BUCKETS] = {};
+        };
+
+        RPCMetrics() = default;
+
+        /// bucket i counts the latencies below 2^i us, the last bucket all longer ones
+        static size_t getBucket(timestamp_t latency_us)
+        {
+            size_t bucket = 0;
+            while (bucket + 1 < FEP_SYSTEM_RPC_LATENCY_BUCKETS && latency_us >= (timestamp_t(1) << bucket))
+            {
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        static timestamp_t getPercentile(const Calls& calls, uint64_t percent)
+        {
+            const uint64_t rank = std::max<uint64_t>((percent * calls.call_count + 99) / 100, 1);
+            uint64_t count = 0;
+            for (size_t bucket = 0; bucket < FEP_SYSTEM_RPC_LATENCY_BUCKETS; ++bucket)
+            {
+                count += calls.buckets[bucket];
+                if (count >= rank)
+                {
+                    return std::min(timestamp_t(1) << bucket, calls.max_time);
+                }
+            }
+            return calls.max_time;
+        }
+
+        std::atomic<bool> _enabled{ false };
+        mutable std::mutex _mutex;
+        std::map<std::tuple<std::string, std::string, std::string>, Calls> _calls;
+    };
+
+    /**
+     * @brief Measures one call for the RPCMetrics if they are enabled.
+     * The call counts as failed if setFailed was called or an exception leaves the scope.
+     * The participant name is referenced, it has to outlive the scope.
+     */
+    class RPCCallScope
+    {
+    public:
+        RPCCallScope(std::string&& participant_name, const char* component, const char* method) = delete;
+        RPCCallScope(const std::string& participant_name, const char* component, const char* method) :
+            _participant_name(participant_name),
+            _component(component),
+            _method(method),
+            _enabled(RPCMetrics::get().isEnabled())
+        {
+            if (_enabled)
+            {
+                _begin = std::chrono::steady_clock::now();
+            }
+        }
+        ~RPCCallScope()
+        {
+            if (_enabled)
+            {
+                const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - _begin).count();
+                RPCMetrics::get().record(_participant_name, _component, _method, latency,
+                    _failed || std::uncaught_exception(), _payload_bytes);
+            }
+        }
+        RPCCallScope(const RPCCallScope&) = delete;
+        RPCCallScope& operator=(const RPCCallScope&) = delete;
+
+        bool isEnabled() const
+        {
+            return _enabled;
+        }
+
+        /// counts the bytes of the texts sent or received
+        void addPayload(size_t bytes)
+        {
+            _payload_bytes += bytes;
+        }
+
+        void setFailed()
+        {
+            _failed = true;
+        }
+
+    private:
+        const std::string& _participant_name;
+        const char* _component;
+        const char* _method;
+        const bool _enabled;
+        bool _failed = false;
+        size_t _payload_bytes = 0;
+        std::chrono::steady_clock::time_point _begin;
+    };
+}
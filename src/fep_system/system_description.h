@@ -0,0 +1,550 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+
+#include <json/json.h>
+#include <a_util/strings.h>
+#include "fep_system/system_configuration.h"
+#include "base/properties/property_type.h"
+#include "base/properties/property_type_conversion.h"
+
+namespace fep
+{
+    /**
+     * @brief Names of the timing modes, one for each System::configureTiming... function
+     */
+    namespace timing_mode
+    {
+        static const char* const custom = "custom";
+        static const char* const fep2_system_time = "fep2_system_time";
+        static const char* const fep2_no_master = "fep2_no_master";
+        static const char* const fep2_afap = "fep2_afap";
+        static const char* const fep3_no_master = "fep3_no_master";
+        static const char* const fep3_clock_sync_only_interpolation = "fep3_clock_sync_only_interpolation";
+        static const char* const fep3_clock_sync_only_discrete = "fep3_clock_sync_only_discrete";
+        static const char* const fep3_discrete_steps = "fep3_discrete_steps";
+        static const char* const fep3_afap = "fep3_afap";
+    }
+
+    /**
+     * @brief The timing of a system, the parameters of the System::configureTiming... functions
+     */
+    struct TimingDescription
+    {
+        std::string mode;
+        std::string master_element_id;
+        std::string master_time_stepsize;
+        std::string master_time_factor;
+        std::string slave_sync_cycle_time;
+        /// custom mode only
+        std::string master_clock_name;
+        /// custom mode only
+        std::string slave_clock_name;
+        /// custom mode only
+        std::string scheduler;
+    };
+
+    struct ParticipantDescription
+    {
+        ParticipantConfiguration properties;
+        bool    has_init_priority = false;
+        int32_t init_priority = 0;
+        bool    has_start_priority = false;
+        int32_t start_priority = 0;
+    };
+
+    /**
+     * @brief The content of a system configuration file
+     */
+    struct SystemDescription
+    {
+        bool                                          has_timing = false;
+        TimingDescription                             timing;
+        /// properties set to every participant of the system
+        ParticipantConfiguration                      properties;
+        std::map<std::string, ParticipantDescription> participants;
+    };
+
+    /**
+     * @brief Reads and validates system configuration files (JSON):
+     * @code
+     * {
+     *     "timing": { "mode": "fep3_discrete_steps", "master": "Master", "master_time_stepsize": "100", "master_time_factor": "1.0" },
+     *     "properties": { "Clock/MainClock": "local_system_simtime", "Node/Value": { "type": "double", "value": "1.0" } },
+     *     "participants": {
+     *         "Master": { "init_priority": 1, "start_priority": 2, "properties": { "Node/Values": [ 1.0, 2.5 ] } }
+     *     }
+     * }
+     * @endcode
+     * Property values are given as JSON boolean, integer, number, string or array (the type is deduced,
+     * numbers written with fraction or exponent like 1.0 are double) or as object with "type" and "value".
+     * A value has to match its type, a string is taken as the string representation of any type.
+     * All findings are collected, so one run reports every error of the file.
+     */
+    class SystemDescriptionReader
+    {
+    public:
+        /**
+         * @brief reads the file
+         *
+         * @param file_path path of the file
+         * @return the validated description
+         * @throw std::runtime_error if the file can not be read or is not valid, with all findings
+         */
+        SystemDescription read(const std::string& file_path)
+        {
+            std::ifstream file(file_path);
+            if (!file.is_open())
+            {
+                throw std::runtime_error("configuration file " + file_path + " can not be opened");
+            }
+
+            Json::CharReaderBuilder builder;
+            Json::Value root;
+            std::string parse_errors;
+            if (!Json::parseFromStream(builder, file, &root, &parse_errors))
+            {
+                throw std::runtime_error("configuration file " + file_path + " is no valid JSON: " + parse_errors);
+            }
+
+            SystemDescription description;
+            try
+            {
+                description = readRoot(root);
+            }
+            catch (const Json::Exception& ex)
+            {
+                throw std::runtime_error("configuration file " + file_path + " is not valid: " + ex.what());
+            }
+            if (!_findings.empty())
+            {
+                throw std::runtime_error("configuration file " + file_path + " is not valid: "
+                    + a_util::strings::join(_findings, "; "));
+            }
+            return description;
+        }
+
+    private:
+        struct TimingMode
+        {
+            const char*              name;
+            std::vector<std::string> required;
+        };
+
+        static const std::vector<TimingMode>& getTimingModes()
+        {
+            static const std::vector<TimingMode> modes =
+            {
+                { timing_mode::custom, { "master_clock", "slave_clock", "scheduler" } },
+                { timing_mode::fep2_system_time, { "master", "master_time_factor" } },
+                { timing_mode::fep2_no_master, {} },
+                { timing_mode::fep2_afap, { "master" } },
+                { timing_mode::fep3_no_master, {} },
+                { timing_mode::fep3_clock_sync_only_interpolation, { "master", "slave_sync_cycle_time" } },
+                { timing_mode::fep3_clock_sync_only_discrete, { "master", "slave_sync_cycle_time" } },
+                { timing_mode::fep3_discrete_steps, { "master", "master_time_stepsize", "master_time_factor" } },
+                { timing_mode::fep3_afap, { "master", "master_time_stepsize" } }
+            };
+            return modes;
+        }
+
+        static bool isKnownType(const std::string& type)
+        {
+            return type == PropertyType<bool>::getTypeName()
+                || type == PropertyType<int32_t>::getTypeName()
+                || type == PropertyType<double>::getTypeName()
+                || type == PropertyType<std::string>::getTypeName()
+                || type == PropertyType<std::vector<bool>>::getTypeName()
+                || type == PropertyType<std::vector<int32_t>>::getTypeName()
+                || type == PropertyType<std::vector<double>>::getTypeName()
+                || type == PropertyType<std::vector<std::string>>::getTypeName();
+        }
+
+        void checkMembers(const Json::Value& object, const std::vector<std::string>& allowed, const std::string& context)
+        {
+            for (const auto& member : object.getMemberNames())
+            {
+                if (std::find(allowed.begin(), allowed.end(), member) == allowed.end())
+                {
+                    _findings.push_back(context + ": unknown entry '" + member + "'");
+                }
+            }
+        }
+
+        SystemDescription readRoot(const Json::Value& root)
+        {
+            SystemDescription description;
+            if (!root.isObject())
+            {
+                _findings.push_back("the root is no object");
+                return description;
+            }
+            checkMembers(root, { "timing", "properties", "participants" }, "root");
+
+            if (root.isMember("timing"))
+            {
+                description.has_timing = true;
+                description.timing = readTiming(root["timing"]);
+            }
+            if (root.isMember("properties"))
+            {
+                description.properties = readProperties(root["properties"], "properties");
+            }
+            if (root.isMember("participants"))
+            {
+                const auto& participants = root["participants"];
+                if (!participants.isObject())
+                {
+                    _findings.push_back("participants: is no object");
+                }
+                else
+                {
+                    for (const auto& name : participants.getMemberNames())
+                    {
+                        description.participants[name] = readParticipant(participants[name], "participants/" + name);
+                    }
+                }
+            }
+            return description;
+        }
+
+        std::string readString(const Json::Value& object, const std::string& member, const std::string& context)
+        {
+            if (!object.isMember(member))
+            {
+                return std::string();
+            }
+            const auto& value = object[member];
+            if (value.isString())
+            {
+                return value.asString();
+            }
+            else if (isNumber(value))
+            {
+                return toNumberString(value);
+            }
+            _findings.push_back(context + "/" + member + ": is no string");
+            return std::string();
+        }
+
+        TimingDescription readTiming(const Json::Value& timing)
+        {
+            TimingDescription description;
+            if (!timing.isObject())
+            {
+                _findings.push_back("timing: is no object");
+                return description;
+            }
+            checkMembers(timing, { "mode", "master", "master_time_stepsize", "master_time_factor", "slave_sync_cycle_time",
+                                   "master_clock", "slave_clock", "scheduler" }, "timing");
+
+            description.mode = readString(timing, "mode", "timing");
+            description.master_element_id = readString(timing, "master", "timing");
+            description.master_time_stepsize = readString(timing, "master_time_stepsize", "timing");
+            description.master_time_factor = readString(timing, "master_time_factor", "timing");
+            description.slave_sync_cycle_time = readString(timing, "slave_sync_cycle_time", "timing");
+            description.master_clock_name = readString(timing, "master_clock", "timing");
+            description.slave_clock_name = readString(timing, "slave_clock", "timing");
+            description.scheduler = readString(timing, "scheduler", "timing");
+
+            const auto& modes = getTimingModes();
+            const auto mode = std::find_if(modes.begin(), modes.end(),
+                [&description](const TimingMode& current) { return description.mode == current.name; });
+            if (mode == modes.end())
+            {
+                _findings.push_back("timing/mode: unknown mode '" + description.mode + "'");
+                return description;
+            }
+            for (const auto& required : mode->required)
+            {
+                if (readString(timing, required, "timing").empty())
+                {
+                    _findings.push_back("timing/" + required + ": is required for mode " + description.mode);
+                }
+            }
+            return description;
+        }
+
+        ParticipantDescription readParticipant(const Json::Value& participant, const std::string& context)
+        {
+            ParticipantDescription description;
+            if (!participant.isObject())
+            {
+                _findings.push_back(context + ": is no object");
+                return description;
+            }
+            checkMembers(participant, { "init_priority", "start_priority", "properties" }, context);
+
+            if (participant.isMember("init_priority"))
+            {
+                description.has_init_priority = readPriority(participant["init_priority"], context + "/init_priority",
+                    description.init_priority);
+            }
+            if (participant.isMember("start_priority"))
+            {
+                description.has_start_priority = readPriority(participant["start_priority"], context + "/start_priority",
+                    description.start_priority);
+            }
+            if (participant.isMember("properties"))
+            {
+                description.properties = readProperties(participant["properties"], context + "/properties");
+            }
+            return description;
+        }
+
+        bool readPriority(const Json::Value& value, const std::string& context, int32_t& priority)
+        {
+            if (!isInteger(value))
+            {
+                _findings.push_back(context + ": is no integer");
+                return false;
+            }
+            priority = value.asInt();
+            return true;
+        }
+
+        ParticipantConfiguration readProperties(const Json::Value& properties, const std::string& context)
+        {
+            ParticipantConfiguration configuration;
+            if (!properties.isObject())
+            {
+                _findings.push_back(context + ": is no object");
+                return configuration;
+            }
+            for (const auto& path : properties.getMemberNames())
+            {
+                PropertyValue value;
+                if (readProperty(properties[path], context + "/" + path, value))
+                {
+                    configuration[path] = value;
+                }
+            }
+            return configuration;
+        }
+
+        bool readProperty(const Json::Value& property, const std::string& context, PropertyValue& value)
+        {
+            if (property.isObject())
+            {
+                checkMembers(property, { "type", "value" }, context);
+                if (!property.isMember("type") || !property["type"].isString() || !property.isMember("value"))
+                {
+                    _findings.push_back(context + ": requires a 'type' and a 'value'");
+                    return false;
+                }
+                value.type = property["type"].asString();
+            }
+            else
+            {
+                value.type = deduceType(property);
+            }
+
+            if (!isKnownType(value.type))
+            {
+                _findings.push_back(context + ": unknown or not deducible type '" + value.type + "'");
+                return false;
+            }
+            // a string is taken as the string representation of any type
+            const Json::Value& json_value = property.isObject() ? property["value"] : property;
+            if (json_value.isString())
+            {
+                value.value = json_value.asString();
+                return true;
+            }
+            if (!toValueString(json_value, value.type, value.value))
+            {
+                _findings.push_back(context + ": the value does not match the type '" + value.type + "'");
+                return false;
+            }
+            return true;
+        }
+
+        /// integer tokens only, jsoncpp also reports integral numbers like 1.0 as int
+        static bool isInteger(const Json::Value& value)
+        {
+            return (value.type() == Json::intValue || value.type() == Json::uintValue) && value.isInt();
+        }
+
+        /// no booleans, older jsoncpp versions count them as numeric
+        static bool isNumber(const Json::Value& value)
+        {
+            return value.type() == Json::intValue || value.type() == Json::uintValue || value.type() == Json::realValue;
+        }
+
+        static bool isBoolean(const Json::Value& value)
+        {
+            return value.isBool();
+        }
+
+        static bool isText(const Json::Value& value)
+        {
+            return value.isString();
+        }
+
+        static bool isArrayOf(const Json::Value& array, bool (*is_element)(const Json::Value&))
+        {
+            for (Json::ArrayIndex idx = 0; idx < array.size(); ++idx)
+            {
+                if (!is_element(array[idx]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static std::string deduceType(const Json::Value& value)
+        {
+            if (isBoolean(value))
+            {
+                return PropertyType<bool>::getTypeName();
+            }
+            else if (isInteger(value))
+            {
+                return PropertyType<int32_t>::getTypeName();
+            }
+            else if (isNumber(value))
+            {
+                return PropertyType<double>::getTypeName();
+            }
+            else if (isText(value))
+            {
+                return PropertyType<std::string>::getTypeName();
+            }
+            else if (value.isArray() && value.size() > 0)
+            {
+                if (isArrayOf(value, &isBoolean))
+                {
+                    return PropertyType<std::vector<bool>>::getTypeName();
+                }
+                else if (isArrayOf(value, &isInteger))
+                {
+                    return PropertyType<std::vector<int32_t>>::getTypeName();
+                }
+                else if (isArrayOf(value, &isNumber))
+                {
+                    return PropertyType<std::vector<double>>::getTypeName();
+                }
+                else if (isArrayOf(value, &isText))
+                {
+                    return PropertyType<std::vector<std::string>>::getTypeName();
+                }
+            }
+            return std::string();
+        }
+
+        template<typename T, typename Get>
+        static bool toArrayString(const Json::Value& array, bool (*is_element)(const Json::Value&), Get get,
+                                  std::string& result)
+        {
+            if (!array.isArray() || !isArrayOf(array, is_element))
+            {
+                return false;
+            }
+            std::vector<T> values;
+            for (Json::ArrayIndex idx = 0; idx < array.size(); ++idx)
+            {
+                values.push_back(get(array[idx]));
+            }
+            result = DefaultPropertyTypeConversion<std::vector<T>>::toString(values);
+            return true;
+        }
+
+        static std::string toNumberString(const Json::Value& value)
+        {
+            return isInteger(value)
+                ? DefaultPropertyTypeConversion<int32_t>::toString(value.asInt())
+                : DefaultPropertyTypeConversion<double>::toString(value.asDouble());
+        }
+
+        /**
+         * @brief converts a JSON value into the string representation of the property type
+         *
+         * @return false if the value does not match the type (i.e. a number for a bool or a string in an int array)
+         */
+        static bool toValueString(const Json::Value& value, const std::string& type, std::string& result)
+        {
+            if (type == PropertyType<bool>::getTypeName())
+            {
+                if (!isBoolean(value))
+                {
+                    return false;
+                }
+                result = DefaultPropertyTypeConversion<bool>::toString(value.asBool());
+            }
+            else if (type == PropertyType<int32_t>::getTypeName())
+            {
+                if (!isInteger(value))
+                {
+                    return false;
+                }
+                result = DefaultPropertyTypeConversion<int32_t>::toString(value.asInt());
+            }
+            else if (type == PropertyType<double>::getTypeName())
+            {
+                if (!isNumber(value))
+                {
+                    return false;
+                }
+                result = DefaultPropertyTypeConversion<double>::toString(value.asDouble());
+            }
+            else if (type == PropertyType<std::string>::getTypeName())
+            {
+                if (!isText(value))
+                {
+                    return false;
+                }
+                result = value.asString();
+            }
+            else if (type == PropertyType<std::vector<bool>>::getTypeName())
+            {
+                return toArrayString<bool>(value, &isBoolean,
+                    [](const Json::Value& element) { return element.asBool(); }, result);
+            }
+            else if (type == PropertyType<std::vector<int32_t>>::getTypeName())
+            {
+                return toArrayString<int32_t>(value, &isInteger,
+                    [](const Json::Value& element) { return element.asInt(); }, result);
+            }
+            else if (type == PropertyType<std::vector<double>>::getTypeName())
+            {
+                return toArrayString<double>(value, &isNumber,
+                    [](const Json::Value& element) { return element.asDouble(); }, result);
+            }
+            else if (type == PropertyType<std::vector<std::string>>::getTypeName())
+            {
+                return toArrayString<std::string>(value, &isText,
+                    [](const Json::Value& element) { return element.asString(); }, result);
+            }
+            else
+            {
+                return false;
+            }
+            return true;
+        }
+
+        std::vector<std::string> _findings;
+    };
+}
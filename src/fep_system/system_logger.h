@@ -19,11 +19,18 @@ You may add additional accurate notices of copyright ownership.
 
 #pragma once
 #include <string>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <cstdio>
+#include <algorithm>
 #include "fep_participant_sdk.h"
-#include "a_util/datetime.h"
 #include "connection_interface.h"
 #include "fep_system/fep_system.h"
 #include "fep_system/system_logger_intf.h"
+#include "monitor_dispatcher.h"
+#include "incident_limiter.h"
+#include "transition_timeline.h"
 
 namespace fep
 {
@@ -31,11 +38,46 @@ namespace fep
     {
     public:
         SystemLogger() = default;
-        void registerMonitor(IEventMonitor* monitor, const std::string& system_name)
+        ~SystemLogger()
         {
-            std::lock_guard<std::recursive_mutex> lock(_logging_sync);
             unregisterMonitor(nullptr);
-            _emm = std::make_shared<EventMonitorMirror>(monitor, _level);
+        }
+
+        void registerMonitor(IEventMonitor* monitor,
+                             const MonitorFilter& filter,
+                             const MonitorBatchOptions& batching,
+                             const std::string& system_name)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_logging_sync);
+            if (!_dispatcher)
+            {
+                _dispatcher.reset(new MonitorDispatcher(system_name, _queue_capacity, _overflow_policy, _time_resolution));
+                _emm = std::make_shared<EventMonitorMirror>(*_dispatcher, _timeline);
+                _emm->setIncidentRateLimit(_incident_rate_limit);
+                //the summaries of ended incident storms are sent without waiting for the next incident
+                std::weak_ptr<EventMonitorMirror> emm = _emm;
+                _dispatcher->setTickTask([emm]()
+                {
+                    auto mirror = emm.lock();
+                    if (mirror)
+                    {
+                        mirror->pushDueIncidentSummaries();
+                    }
+                });
+            }
+            if (!_dispatcher->addMonitor(*monitor, filter, batching))
+            {
+                _emm->onLog("The EventMonitor is already registered",
+                           logging::SEVERITY_ERROR,
+                           system_name);
+                throw std::runtime_error{ "Duplicated listener registration detected!" };
+            }
+            updateEnabledLevel();
+            if (_active_emm.load())
+            {
+                return;
+            }
+            _active_emm.store(_emm.get());
             if (isFailed(_coin.getAI().RegisterMonitoring("*", _emm.get())))
             {
                 _emm->onLog("The EventMonitor is already registered",
@@ -52,15 +94,53 @@ namespace fep
             }
         }
 
-        void unregisterMonitor(IEventMonitor*)
+        /**
+         * @brief unregisters @p monitor, all monitors if nullptr.
+         * The events issued before are delivered before this function returns.
+         */
+        void unregisterMonitor(IEventMonitor* monitor)
         {
-            std::lock_guard<std::recursive_mutex> lock(_logging_sync);
-            if (_emm)
+            MonitorDispatcher* dispatcher = nullptr;
             {
-                _coin.getAI().UnregisterMonitoring(_emm.get());
-                _coin.getAI().DisassociateCatchAllStrategy(_emm.get());
+                std::lock_guard<std::recursive_mutex> lock(_logging_sync);
+                dispatcher = _dispatcher.get();
+            }
+            if (!dispatcher)
+            {
+                return;
+            }
+            //the mirror lives as long as the dispatcher
+            _emm->pushIncidentSummaries();
+            //the dispatcher lives as long as this logger, wait outside of the lock so the monitors may still log
+            dispatcher->flush();
+
+            std::vector<std::shared_ptr<MonitorDelivery>> removed;
+            {
+                std::lock_guard<std::recursive_mutex> lock(_logging_sync);
+                if (monitor)
+                {
+                    auto delivery = _dispatcher->removeMonitor(*monitor);
+                    if (delivery)
+                    {
+                        removed.push_back(delivery);
+                    }
+                }
+                else
+                {
+                    removed = _dispatcher->removeAllMonitors();
+                }
+                updateEnabledLevel();
+                if (!_dispatcher->hasMonitors() && _active_emm.load())
+                {
+                    _coin.getAI().UnregisterMonitoring(_emm.get());
+                    _coin.getAI().DisassociateCatchAllStrategy(_emm.get());
+                    _active_emm.store(nullptr);
+                }
+            }
+            for (const auto& delivery : removed)
+            {
+                delivery->close();
             }
-            _emm = nullptr;
         }
 
         void log(logging::Category cat,
@@ -69,45 +149,103 @@ namespace fep
             const std::string& logger_name, //depends on the Category ... 
             const std::string& message) const
         {
-            std::lock_guard<std::recursive_mutex> lock(_logging_sync);
-            if (_emm)
+            if (!isLogEnabled(level))
+            {
+                return;
+            }
+            //no lock on the hot path, the mirror lives as long as this logger
+            auto emm = _active_emm.load();
+            if (emm)
             {
-                _emm->onLog(cat, level, 
+                emm->onLog(cat, level, 
                     participant_name, logger_name, message);
             }
         }
 
+        bool isLogEnabled(logging::Severity level) const override
+        {
+            return isSeverityEnabled(level, _enabled_level.load(std::memory_order_relaxed));
+        }
+
         void setSeverityLevel(logging::Severity level)
         {
             std::lock_guard<std::recursive_mutex> lock(_logging_sync);
             _level = level;
+            updateEnabledLevel();
+        }
+
+        void setMonitoringTimeResolution(MonitorTimeResolution resolution)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_logging_sync);
+            _time_resolution = resolution;
+            if (_dispatcher)
+            {
+                _dispatcher->setTimeResolution(resolution);
+            }
+        }
+
+        void setMonitoringQueue(size_t capacity, MonitorOverflowPolicy policy)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_logging_sync);
+            _queue_capacity = capacity;
+            _overflow_policy = policy;
+            if (_dispatcher)
+            {
+                _dispatcher->setQueue(capacity, policy);
+            }
+        }
+
+        /**
+         * @brief queues a change of the system's participants for the monitors, dropped if no monitor is registered
+         */
+        void pushMembershipChanged(const std::string& participant_name, bool added)
+        {
+            //the dispatcher lives as long as this logger once the mirror is active
+            if (_active_emm.load())
+            {
+                _dispatcher->pushMembershipChanged(participant_name, added);
+            }
+        }
+
+        TransitionTimeline& getTransitionTimeline()
+        {
+            return _timeline;
+        }
+
+        void setIncidentRateLimit(const IncidentRateLimit& limit)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_logging_sync);
+            _incident_rate_limit = limit;
             if (_emm)
             {
-                _emm->setSeverityLevel(level);
+                _emm->setIncidentRateLimit(limit);
             }
         }
 
     private:
-
+        /**
+         * @brief Receives the events from the automation interface and queues them for the monitors,
+         * the monitors are called from the delivery threads of the MonitorDispatcher.
+         * Incidents are rate limited per source and incident code by an IncidentLimiter.
+         */
         class EventMonitorMirror : public IAutomationParticipantMonitor,
                                    public IAutomationIncidentStrategy
         {
         public:
-            explicit EventMonitorMirror(IEventMonitor* monitor, logging::Severity level) 
-                : _monitor(monitor), _level(level)
+            EventMonitorMirror(MonitorDispatcher& dispatcher, TransitionTimeline& timeline) :
+                _dispatcher(dispatcher), _timeline(timeline)
             {
             }
 
             void OnNameChanged(const std::string& sender, const std::string& old_name) override
             {
-                std::lock_guard<std::recursive_mutex> lock(_monitor_access_sync);
-                _monitor->onNameChanged(sender, old_name);
+                _dispatcher.pushNameChanged(sender, old_name);
             }
 
             void OnStateChanged(const std::string& sender, tState state) override
             {
-                std::lock_guard<std::recursive_mutex> lock(_monitor_access_sync);
-                _monitor->onStateChanged(sender, state);
+                _timeline.recordArrival(sender, state);
+                _dispatcher.pushStateChanged(sender, state);
             }
 
             static logging::Severity getSeverityFromLevel(fep::tSeverityLevel level)
@@ -132,63 +270,129 @@ namespace fep
                 const timestamp_t tmSimTime,
                 const char* strDescription) override
             {
-                std::lock_guard<std::recursive_mutex> lock(_monitor_access_sync);
-                std::string message;
-                if (strDescription && strlen(strDescription) > 0)
+                const auto severity = getSeverityFromLevel(eSeverity);
+                if (!isSeverityEnabled(severity, _level.load(std::memory_order_relaxed)))
                 {
-                    message = strDescription;
+                    return {};
                 }
-                else
+                std::vector<IncidentLimiter::Summary> summaries;
+                const bool admitted = _limiter.admit(strSource, nIncident, severity, tmSimTime, summaries);
+                pushSummaries(summaries);
+                if (!admitted)
                 {
-                    message = "Incident number: " + std::to_string(nIncident);
+                    return {};
                 }
 
-                std::string source_to_set;
-                if (strSource && strlen(strSource) > 0)
+                LogText message(strDescription);
+                char incident_message[32];
+                if (message.size == 0)
                 {
-                    source_to_set = strDescription;
+                    const int size = snprintf(incident_message, sizeof(incident_message), "Incident number: %d",
+                        static_cast<int>(nIncident));
+                    message = LogText(incident_message, static_cast<size_t>(std::max(size, 0)));
                 }
-                onLog(logging::Category::CATEGORY_PARTICIPANT,
-                    getSeverityFromLevel(eSeverity),
-                    strSource,
-                    strSource,
+
+                const LogText source(strSource);
+                _dispatcher.pushLog(tmSimTime,
+                    logging::Category::CATEGORY_PARTICIPANT,
+                    severity,
+                    source,
+                    source,
                     message);
                 return {};
             }
 
             void onLog(logging::Category category,
                 logging::Severity received_severity,
-                const std::string& participant_name,
-                const std::string& logger_name, //depends on the Category ... 
-                const std::string& message) const
+                LogText participant_name,
+                LogText logger_name, //depends on the Category ... 
+                LogText message)
             {
-                std::lock_guard<std::recursive_mutex> lock(_monitor_access_sync);
-                const auto timestamp_julian = a_util::datetime::getCurrentLocalDateTime().toTimestamp();
-                _monitor->onLog(timestamp_julian, category, received_severity,
-                    participant_name, logger_name, message);
-
+                _dispatcher.pushLog(-1,
+                    category, received_severity, participant_name, logger_name, message);
             }
             void onLog(const std::string& message,
                        logging::Severity received_severity,
-                       const std::string& system_name) const
+                       const std::string& system_name)
             {
-                std::lock_guard<std::recursive_mutex> lock(_monitor_access_sync);
-                const auto timestamp_julian = a_util::datetime::getCurrentLocalDateTime().toTimestamp();
-                _monitor->onLog(timestamp_julian, logging::CATEGORY_SYSTEM, received_severity,
-                    "", system_name, message);
+                onLog(logging::CATEGORY_SYSTEM, received_severity, "", system_name, message);
             }
             void setSeverityLevel(logging::Severity level)
             {
-                std::lock_guard<std::recursive_mutex> lock(_monitor_access_sync);
-                _level = level;
+                _level.store(level);
+            }
+
+            void setIncidentRateLimit(const IncidentRateLimit& limit)
+            {
+                _limiter.setLimit(limit);
+            }
+
+            /// queues the summaries which are due
+            void pushDueIncidentSummaries()
+            {
+                std::vector<IncidentLimiter::Summary> summaries;
+                _limiter.collectDueSummaries(summaries);
+                pushSummaries(summaries);
+            }
+
+            /// queues the summaries of all incidents coalesced so far
+            void pushIncidentSummaries()
+            {
+                std::vector<IncidentLimiter::Summary> summaries;
+                _limiter.collectSummaries(summaries);
+                pushSummaries(summaries);
             }
-            IEventMonitor* _monitor;
-            mutable std::recursive_mutex _monitor_access_sync;
-            logging::Severity _level = logging::SEVERITY_INFO;
+
+        private:
+            void pushSummaries(const std::vector<IncidentLimiter::Summary>& summaries)
+            {
+                for (const auto& summary : summaries)
+                {
+                    const std::string message = a_util::strings::format(
+                        "%d occurrences in %d ms of incident %d were coalesced by the incident rate limit",
+                        static_cast<int>(summary.count),
+                        static_cast<int>(summary.duration_ms),
+                        static_cast<int>(summary.incident));
+                    _dispatcher.pushLog(summary.simulation_time,
+                        logging::Category::CATEGORY_PARTICIPANT,
+                        summary.severity,
+                        summary.source,
+                        summary.source,
+                        message);
+                }
+            }
+
+
+            MonitorDispatcher& _dispatcher;
+            TransitionTimeline& _timeline;
+            std::atomic<logging::Severity> _level{ logging::SEVERITY_OFF };
+            IncidentLimiter _limiter;
         };
+
+        /// a log is enabled if the system level and at least one monitor select it
+        void updateEnabledLevel()
+        {
+            auto level = _dispatcher ? std::min(_level, _dispatcher->getMaxSeverityLevel()) : logging::SEVERITY_OFF;
+            _enabled_level.store(level);
+            if (_emm)
+            {
+                _emm->setSeverityLevel(level);
+            }
+        }
+
+        /// created with the first registered monitor and kept until destruction
+        std::unique_ptr<MonitorDispatcher> _dispatcher;
         std::shared_ptr<EventMonitorMirror> _emm;
+        /// the mirror while monitors are registered
+        std::atomic<EventMonitorMirror*> _active_emm{ nullptr };
         ConnectionInterface _coin;
         logging::Severity _level = logging::SEVERITY_INFO;
+        std::atomic<logging::Severity> _enabled_level{ logging::SEVERITY_OFF };
+        size_t _queue_capacity = FEP_SYSTEM_MONITOR_QUEUE_CAPACITY;
+        MonitorOverflowPolicy _overflow_policy = MonitorOverflowPolicy::drop_oldest;
+        MonitorTimeResolution _time_resolution = MonitorTimeResolution::microseconds;
+        IncidentRateLimit _incident_rate_limit;
+        TransitionTimeline _timeline;
         mutable std::recursive_mutex _logging_sync;
     };
 }
@@ -0,0 +1,361 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <string>
+#include <vector>
+#include <set>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include "fep_system/fep_system.h"
+
+namespace fep
+{
+    /**
+     * @brief Collects the trace spans of the system control operations of this process
+     * and writes them as Chrome trace event JSON (viewable in chrome://tracing or Perfetto).
+     *
+     * Every thread appends its spans to an own buffer, its lock is only contended while the trace is written or cleared.
+     * When a thread ends its spans are moved to the spans of the finished threads and its buffer is released,
+     * so the short lived threads of the parallel participant calls do not accumulate buffers.
+     * At most @ref FEP_SYSTEM_TRACE_BUFFER_SIZE spans are kept in total, later spans are dropped and counted.
+     * Disabled by default, a disabled span costs one relaxed atomic load.
+     */
+    class TraceRecorder
+    {
+    public:
+        struct Span
+        {
+            const char* category;
+            const char* name;
+            std::string participant_name;
+            std::string detail;
+            timestamp_t begin_us;
+            timestamp_t duration_us;
+            uint32_t thread_id;
+        };
+
+        static TraceRecorder& get()
+        {
+            static TraceRecorder recorder;
+            return recorder;
+        }
+
+        bool isEnabled() const
+        {
+            return _enabled.load(std::memory_order_relaxed);
+        }
+
+        void setEnabled(bool enabled)
+        {
+            _enabled.store(enabled, std::memory_order_relaxed);
+        }
+
+        /// microseconds since the creation of the recorder
+        timestamp_t nowMicroseconds() const
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - _epoch).count();
+        }
+
+        void add(Span&& span)
+        {
+            if (_span_count.fetch_add(1, std::memory_order_relaxed) >= FEP_SYSTEM_TRACE_BUFFER_SIZE)
+            {
+                _span_count.fetch_sub(1, std::memory_order_relaxed);
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            ThreadBuffer& buffer = getThreadBuffer();
+            std::lock_guard<std::mutex> lock(buffer.mutex);
+            span.thread_id = buffer.thread_id;
+            buffer.spans.push_back(std::move(span));
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(_buffers_mutex);
+            for (const auto& buffer : _buffers)
+            {
+                std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+                _span_count.fetch_sub(buffer->spans.size(), std::memory_order_relaxed);
+                std::vector<Span>().swap(buffer->spans);
+            }
+            _span_count.fetch_sub(_finished_spans.size(), std::memory_order_relaxed);
+            std::vector<Span>().swap(_finished_spans);
+            _dropped.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief writes the spans of all threads as complete events ("ph":"X"), one track per thread
+         *
+         * @throw runtime_error if the file can not be written
+         */
+        void write(const std::string& file_path) const
+        {
+            std::ofstream file(file_path, std::ios::trunc);
+            if (!file)
+            {
+                throw std::runtime_error("the trace can not be written to " + file_path);
+            }
+            file << "{\"traceEvents\":[";
+            bool first = true;
+            {
+                std::lock_guard<std::mutex> lock(_buffers_mutex);
+                std::set<uint32_t> finished_threads;
+                for (const auto& span : _finished_spans)
+                {
+                    finished_threads.insert(span.thread_id);
+                }
+                for (const auto thread_id : finished_threads)
+                {
+                    writeThreadName(file, thread_id, first);
+                }
+                for (const auto& span : _finished_spans)
+                {
+                    writeSpan(file, span);
+                }
+                for (const auto& buffer : _buffers)
+                {
+                    std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+                    writeThreadName(file, buffer->thread_id, first);
+                    for (const auto& span : buffer->spans)
+                    {
+                        writeSpan(file, span);
+                    }
+                }
+            }
+            file << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_spans\":"
+                << _dropped.load(std::memory_order_relaxed) << "}}\n";
+            if (!file.flush())
+            {
+                throw std::runtime_error("the trace can not be written to " + file_path);
+            }
+        }
+
+    private:
+        struct ThreadBuffer
+        {
+            std::mutex mutex;
+            std::vector<Span> spans;
+            uint32_t thread_id = 0;
+        };
+
+        /// releases the buffer of the thread when it ends
+        struct ThreadBufferOwner
+        {
+            ~ThreadBufferOwner()
+            {
+                if (buffer)
+                {
+                    TraceRecorder::get().release(buffer);
+                }
+            }
+            std::shared_ptr<ThreadBuffer> buffer;
+        };
+
+        TraceRecorder() : _epoch(std::chrono::steady_clock::now())
+        {
+        }
+
+        ThreadBuffer& getThreadBuffer()
+        {
+            thread_local ThreadBufferOwner owner;
+            if (!owner.buffer)
+            {
+                owner.buffer = std::make_shared<ThreadBuffer>();
+                std::lock_guard<std::mutex> lock(_buffers_mutex);
+                owner.buffer->thread_id = ++_last_thread_id;
+                _buffers.push_back(owner.buffer);
+            }
+            return *owner.buffer;
+        }
+
+        /// keeps the spans of the ended thread, so they are still written
+        void release(const std::shared_ptr<ThreadBuffer>& buffer)
+        {
+            std::lock_guard<std::mutex> lock(_buffers_mutex);
+            {
+                std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+                std::move(buffer->spans.begin(), buffer->spans.end(), std::back_inserter(_finished_spans));
+            }
+            _buffers.erase(std::remove(_buffers.begin(), _buffers.end(), buffer), _buffers.end());
+        }
+
+        static void writeThreadName(std::ostream& stream, uint32_t thread_id, bool& first)
+        {
+            stream << (first ? "\n" : ",\n");
+            first = false;
+            stream << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << thread_id
+                << ",\"name\":\"thread_name\",\"args\":{\"name\":\"thread " << thread_id << "\"}}";
+        }
+
+        static void writeSpan(std::ostream& stream, const Span& span)
+        {
+            stream << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << span.thread_id
+                << ",\"cat\":\"" << span.category << "\",\"name\":\"" << span.name
+                << "\",\"ts\":" << span.begin_us << ",\"dur\":" << span.duration_us;
+            if (!span.participant_name.empty() || !span.detail.empty())
+            {
+                stream << ",\"args\":{";
+                if (!span.participant_name.empty())
+                {
+                    stream << "\"participant\":";
+                    writeString(stream, span.participant_name);
+                }
+                if (!span.detail.empty())
+                {
+                    stream << (span.participant_name.empty() ? "\"detail\":" : ",\"detail\":");
+                    writeString(stream, span.detail);
+                }
+                stream << "}";
+            }
+            stream << "}";
+        }
+
+        static void writeString(std::ostream& stream, const std::string& text)
+        {
+            stream << '"';
+            for (const char c : text)
+            {
+                switch (c)
+                {
+                case '"':
+                    stream << "\\\"";
+                    break;
+                case '\\':
+                    stream << "\\\\";
+                    break;
+                case '\n':
+                    stream << "\\n";
+                    break;
+                case '\r':
+                    stream << "\\r";
+                    break;
+                case '\t':
+                    stream << "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+                        stream << escaped;
+                    }
+                    else
+                    {
+                        stream << c;
+                    }
+                    break;
+                }
+            }
+            stream << '"';
+        }
+
+        const std::chrono::steady_clock::time_point _epoch;
+        std::atomic<bool> _enabled{ false };
+        /// the spans kept in all buffers, limited to FEP_SYSTEM_TRACE_BUFFER_SIZE
+        std::atomic<size_t> _span_count{ 0 };
+        std::atomic<uint64_t> _dropped{ 0 };
+        /// guards the buffer list, the spans of the finished threads and the thread ids
+        mutable std::mutex _buffers_mutex;
+        std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+        std::vector<Span> _finished_spans;
+        uint32_t _last_thread_id = 0;
+    };
+
+    /**
+     * @brief Records one span for the TraceRecorder if tracing is enabled.
+     * @p category and @p name have to be literals, the texts are only copied while tracing is enabled.
+     */
+    class TraceScope
+    {
+    public:
+        TraceScope(const char* category, const char* name) :
+            TraceScope(category, name, nullptr, nullptr)
+        {
+        }
+        TraceScope(const char* category, const char* name, const std::string& detail) :
+            TraceScope(category, name, nullptr, &detail)
+        {
+        }
+        TraceScope(const char* category, const char* name,
+                   const std::string& participant_name, const std::string& detail) :
+            TraceScope(category, name, &participant_name, &detail)
+        {
+        }
+        ~TraceScope()
+        {
+            if (_enabled)
+            {
+                auto& recorder = TraceRecorder::get();
+                _span.duration_us = recorder.nowMicroseconds() - _span.begin_us;
+                recorder.add(std::move(_span));
+            }
+        }
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+        bool isEnabled() const
+        {
+            return _enabled;
+        }
+
+        /// replaces the detail shown in the arguments of the span
+        void setDetail(std::string detail)
+        {
+            if (_enabled)
+            {
+                _span.detail = std::move(detail);
+            }
+        }
+
+    private:
+        TraceScope(const char* category, const char* name,
+                   const std::string* participant_name, const std::string* detail) :
+            _enabled(TraceRecorder::get().isEnabled())
+        {
+            if (_enabled)
+            {
+                _span.category = category;
+                _span.name = name;
+                if (participant_name)
+                {
+                    _span.participant_name = *participant_name;
+                }
+                if (detail)
+                {
+                    _span.detail = *detail;
+                }
+                _span.begin_us = TraceRecorder::get().nowMicroseconds();
+            }
+        }
+
+        const bool _enabled;
+        TraceRecorder::Span _span{};
+    };
+}
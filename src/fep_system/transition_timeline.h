@@ -0,0 +1,228 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <algorithm>
+#include <chrono>
+
+#include "fep_participant_sdk.h"
+#include "fep_system/fep_system.h"
+#include "log_clock.h"
+
+namespace fep
+{
+    /**
+     * @brief Timestamps the triggers of the participants and the arrivals in the target states.
+     *
+     * A trigger waits for the arrival of its participant in the target state,
+     * the first observed arrival ends it and its latency is added to the histogram of the participant and transition.
+     * A newer trigger of the same participant replaces a pending one.
+     * The latencies are measured on the steady clock, the events of the timeline carry the time of the log clock.
+     */
+    class TransitionTimeline
+    {
+    public:
+        /**
+         * @brief the target state of the control event @p event
+         *
+         * @return false if the event has no target state (i.e. CE_ErrorFixed)
+         */
+        static bool getTargetState(tControlEvent event, tState& target_state)
+        {
+            switch (event)
+            {
+            case CE_Initialize:
+                target_state = FS_READY;
+                return true;
+            case CE_Start:
+                target_state = FS_RUNNING;
+                return true;
+            case CE_Stop:
+                target_state = FS_IDLE;
+                return true;
+            case CE_Shutdown:
+                target_state = FS_SHUTDOWN;
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        static std::string getTransitionName(tState target_state)
+        {
+            switch (target_state)
+            {
+            case FS_READY:
+                return "initialize";
+            case FS_RUNNING:
+                return "start";
+            case FS_IDLE:
+                return "stop";
+            case FS_SHUTDOWN:
+                return "shutdown";
+            default:
+                return "unknown";
+            }
+        }
+
+        void recordTrigger(const std::string& participant_name, tControlEvent event)
+        {
+            tState target_state;
+            if (!getTargetState(event, target_state))
+            {
+                return;
+            }
+            const auto trigger_time = std::chrono::steady_clock::now();
+            const timestamp_t now = LogClock::get().nowMicroseconds();
+            std::lock_guard<std::mutex> lock(_mutex);
+            addEvent(TransitionEvent{ participant_name, target_state, true, now });
+            _pending[participant_name] = Pending{ target_state, trigger_time };
+        }
+
+        void recordArrival(const std::string& participant_name, tState state)
+        {
+            const auto arrival_time = std::chrono::steady_clock::now();
+            const timestamp_t now = LogClock::get().nowMicroseconds();
+            std::lock_guard<std::mutex> lock(_mutex);
+            const auto pending = _pending.find(participant_name);
+            if (pending == _pending.end() || pending->second.target_state != state)
+            {
+                return;
+            }
+            addEvent(TransitionEvent{ participant_name, state, false, now });
+            _histograms[std::make_pair(participant_name, state)].add(
+                std::chrono::duration_cast<std::chrono::microseconds>(arrival_time - pending->second.trigger_time).count());
+            _pending.erase(pending);
+        }
+
+        std::vector<TransitionEvent> getTimeline() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return std::vector<TransitionEvent>(_timeline.begin(), _timeline.end());
+        }
+
+        std::vector<TransitionLatency> getLatencies() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::vector<TransitionLatency> latencies;
+            for (const auto& histogram : _histograms)
+            {
+                TransitionLatency latency;
+                latency.participant_name = histogram.first.first;
+                latency.target_state = histogram.first.second;
+                latency.transition = getTransitionName(histogram.first.second);
+                histogram.second.fill(latency);
+                latencies.push_back(std::move(latency));
+            }
+            return latencies;
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _timeline.clear();
+            _pending.clear();
+            _histograms.clear();
+        }
+
+    private:
+        struct Pending
+        {
+            tState target_state;
+            std::chrono::steady_clock::time_point trigger_time;
+        };
+
+        /**
+         * @brief count, min and max of all latencies, the percentiles of the latest ones
+         */
+        class Histogram
+        {
+        public:
+            void add(timestamp_t latency)
+            {
+                if (_count == 0)
+                {
+                    _min = latency;
+                    _max = latency;
+                }
+                _min = std::min(_min, latency);
+                _max = std::max(_max, latency);
+                ++_count;
+                if (_samples.size() < FEP_SYSTEM_TRANSITION_LATENCY_SAMPLES)
+                {
+                    _samples.push_back(latency);
+                }
+                else
+                {
+                    _samples[_next_sample] = latency;
+                }
+                _next_sample = (_next_sample + 1) % FEP_SYSTEM_TRANSITION_LATENCY_SAMPLES;
+            }
+
+            void fill(TransitionLatency& latency) const
+            {
+                auto sorted = _samples;
+                std::sort(sorted.begin(), sorted.end());
+                latency.count = _count;
+                latency.min = _min;
+                latency.max = _max;
+                latency.p50 = getPercentile(sorted, 50);
+                latency.p95 = getPercentile(sorted, 95);
+                latency.p99 = getPercentile(sorted, 99);
+            }
+
+        private:
+            /// nearest rank percentile
+            static timestamp_t getPercentile(const std::vector<timestamp_t>& sorted, size_t percent)
+            {
+                if (sorted.empty())
+                {
+                    return 0;
+                }
+                const size_t rank = (percent * sorted.size() + 99) / 100;
+                return sorted[std::max<size_t>(rank, 1) - 1];
+            }
+
+            size_t _count = 0;
+            timestamp_t _min = 0;
+            timestamp_t _max = 0;
+            std::vector<timestamp_t> _samples;
+            size_t _next_sample = 0;
+        };
+
+        void addEvent(TransitionEvent event)
+        {
+            if (_timeline.size() >= FEP_SYSTEM_TRANSITION_TIMELINE_SIZE)
+            {
+                _timeline.pop_front();
+            }
+            _timeline.push_back(std::move(event));
+        }
+
+        mutable std::mutex _mutex;
+        std::deque<TransitionEvent> _timeline;
+        std::map<std::string, Pending> _pending;
+        std::map<std::pair<std::string, tState>, Histogram> _histograms;
+    };
+}
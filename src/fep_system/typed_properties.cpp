@@ -0,0 +1,132 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+
+#include <fep_system/typed_properties.h>
+#include "base/properties/property_type.h"
+#include "base/properties/property_type_conversion.h"
+#include "typed_properties_intf.h"
+
+namespace fep
+{
+    namespace
+    {
+        template<typename T>
+        bool setValue(IProperties& properties, const std::string& name, const T& value)
+        {
+            auto typed_properties = dynamic_cast<ITypedProperties*>(&properties);
+            if (typed_properties)
+            {
+                return typed_properties->setTypedProperty(name, value);
+            }
+            return properties.setProperty(name,
+                DefaultPropertyTypeConversion<T>::toString(value),
+                PropertyType<T>::getTypeName());
+        }
+
+        template<typename T>
+        bool getValue(const IProperties& properties, const std::string& name, T& value)
+        {
+            auto typed_properties = dynamic_cast<const ITypedProperties*>(&properties);
+            if (typed_properties)
+            {
+                return typed_properties->getTypedProperty(name, value);
+            }
+            if (properties.getPropertyType(name) != PropertyType<T>::getTypeName())
+            {
+                return false;
+            }
+            value = DefaultPropertyTypeConversion<T>::fromString(properties.getProperty(name));
+            return true;
+        }
+    }
+
+    bool setPropertyValue(IProperties& properties, const std::string& name, bool value)
+    {
+        return setValue(properties, name, value);
+    }
+    bool setPropertyValue(IProperties& properties, const std::string& name, int32_t value)
+    {
+        return setValue(properties, name, value);
+    }
+    bool setPropertyValue(IProperties& properties, const std::string& name, double value)
+    {
+        return setValue(properties, name, value);
+    }
+    bool setPropertyValue(IProperties& properties, const std::string& name, const std::string& value)
+    {
+        return setValue(properties, name, value);
+    }
+    bool setPropertyValue(IProperties& properties, const std::string& name, const std::vector<bool>& value)
+    {
+        return setValue(properties, name, value);
+    }
+    bool setPropertyValue(IProperties& properties, const std::string& name, const std::vector<int32_t>& value)
+    {
+        return setValue(properties, name, value);
+    }
+    bool setPropertyValue(IProperties& properties, const std::string& name, const std::vector<double>& value)
+    {
+        return setValue(properties, name, value);
+    }
+    bool setPropertyValue(IProperties& properties, const std::string& name, const std::vector<std::string>& value)
+    {
+        return setValue(properties, name, value);
+    }
+
+    bool getPropertyValue(const IProperties& properties, const std::string& name, bool& value)
+    {
+        return getValue(properties, name, value);
+    }
+    bool getPropertyValue(const IProperties& properties, const std::string& name, int32_t& value)
+    {
+        return getValue(properties, name, value);
+    }
+    bool getPropertyValue(const IProperties& properties, const std::string& name, double& value)
+    {
+        return getValue(properties, name, value);
+    }
+    bool getPropertyValue(const IProperties& properties, const std::string& name, std::string& value)
+    {
+        return getValue(properties, name, value);
+    }
+    bool getPropertyValue(const IProperties& properties, const std::string& name, std::vector<bool>& value)
+    {
+        return getValue(properties, name, value);
+    }
+    bool getPropertyValue(const IProperties& properties, const std::string& name, std::vector<int32_t>& value)
+    {
+        return getValue(properties, name, value);
+    }
+    bool getPropertyValue(const IProperties& properties, const std::string& name, std::vector<double>& value)
+    {
+        return getValue(properties, name, value);
+    }
+    bool getPropertyValue(const IProperties& properties, const std::string& name, std::vector<std::string>& value)
+    {
+        return getValue(properties, name, value);
+    }
+
+    void refreshProperties(const IProperties& properties)
+    {
+        auto cached_properties = dynamic_cast<const ICachedProperties*>(&properties);
+        if (cached_properties)
+        {
+            cached_properties->refresh();
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 AUDI AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "fep_system/system_configuration.h"
+
+namespace fep
+{
+    /**
+     * @brief Typed access to a properties node of the configuration proxies.
+     * Implemented next to IProperties by the property nodes of fep::ConfigurationProxy and
+     * fep::ConfigurationProxyOldSql, so the typed accessors do not need to convert the value
+     * to a string and dispatch on the type name.
+     */
+    class ITypedProperties
+    {
+    protected:
+        virtual ~ITypedProperties() = default;
+
+    public:
+        virtual bool setTypedProperty(const std::string& name, bool value) = 0;
+        virtual bool setTypedProperty(const std::string& name, int32_t value) = 0;
+        virtual bool setTypedProperty(const std::string& name, double value) = 0;
+        virtual bool setTypedProperty(const std::string& name, const std::string& value) = 0;
+        virtual bool setTypedProperty(const std::string& name, const std::vector<bool>& value) = 0;
+        virtual bool setTypedProperty(const std::string& name, const std::vector<int32_t>& value) = 0;
+        virtual bool setTypedProperty(const std::string& name, const std::vector<double>& value) = 0;
+        virtual bool setTypedProperty(const std::string& name, const std::vector<std::string>& value) = 0;
+
+        virtual bool getTypedProperty(const std::string& name, bool& value) const = 0;
+        virtual bool getTypedProperty(const std::string& name, int32_t& value) const = 0;
+        virtual bool getTypedProperty(const std::string& name, double& value) const = 0;
+        virtual bool getTypedProperty(const std::string& name, std::string& value) const = 0;
+        virtual bool getTypedProperty(const std::string& name, std::vector<bool>& value) const = 0;
+        virtual bool getTypedProperty(const std::string& name, std::vector<int32_t>& value) const = 0;
+        virtual bool getTypedProperty(const std::string& name, std::vector<double>& value) const = 0;
+        virtual bool getTypedProperty(const std::string& name, std::vector<std::string>& value) const = 0;
+    };
+
+    /**
+     * @brief A properties node of the configuration proxies which keeps the values it retrieved once.
+     */
+    class ICachedProperties
+    {
+    protected:
+        virtual ~ICachedProperties() = default;
+
+    public:
+        /**
+         * @brief drops the retrieved values, the next read will retrieve them again
+         */
+        virtual void refresh() const = 0;
+    };
+
+    /**
+     * @brief A properties node of the configuration proxies which reads all properties below it at once.
+     */
+    class IPropertyTreeReader
+    {
+    protected:
+        virtual ~IPropertyTreeReader() = default;
+
+    public:
+        /**
+         * @brief reads type and value of every property below this node (recursively),
+         * nodes without a value are skipped
+         *
+         * @param values will contain the properties keyed by their path relative to this node ('/' separated)
+         */
+        virtual void readTree(ParticipantConfiguration& values) const = 0;
+    };
+}
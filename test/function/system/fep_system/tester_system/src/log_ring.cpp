@@ -0,0 +1,245 @@
+/**
+ *
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ *
+ *
+ * @remarks
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "log_ring.h"
+
+using namespace fep;
+
+namespace
+{
+    bool pushLog(LogRing& ring, timestamp_t time, const std::string& participant_name, const std::string& message)
+    {
+        return ring.tryPush(MonitorEvent::Type::log, time, -1, logging::CATEGORY_SYSTEM, logging::SEVERITY_INFO,
+            FS_UNKNOWN, participant_name, "logger", message);
+    }
+}
+
+/**
+ * @brief The events are taken in order while the positions wrap around the slots several times
+ * @req_id <todo>
+ */
+TEST(LogRing, WrapAround)
+{
+    LogRing ring(5);
+    MonitorEvent event;
+    ASSERT_TRUE(ring.isEmpty());
+    ASSERT_FALSE(ring.tryPop(&event));
+
+    // 8 slots, the limit is the requested capacity
+    for (timestamp_t idx = 0; idx < 5; ++idx)
+    {
+        ASSERT_TRUE(pushLog(ring, idx, "part", std::to_string(idx)));
+    }
+    ASSERT_FALSE(pushLog(ring, 5, "part", "5"));
+    for (timestamp_t idx = 0; idx < 5; ++idx)
+    {
+        ASSERT_TRUE(ring.tryPop(&event));
+        ASSERT_EQ(event.log_time, idx);
+        ASSERT_EQ(event.message, std::to_string(idx));
+    }
+    ASSERT_TRUE(ring.isEmpty());
+
+    // alternating push and pop of 1 to 3 events, so every slot is reused at every fill level
+    timestamp_t pushed = 5;
+    timestamp_t popped = 5;
+    for (size_t round = 0; round < 100; ++round)
+    {
+        for (size_t count = 0; count < round % 3 + 1; ++count)
+        {
+            ASSERT_TRUE(pushLog(ring, pushed, "part", std::to_string(pushed)));
+            ++pushed;
+        }
+        while (ring.tryPop(&event))
+        {
+            ASSERT_EQ(event.type, MonitorEvent::Type::log);
+            ASSERT_EQ(event.log_time, popped);
+            ASSERT_EQ(event.simulation_time, -1);
+            ASSERT_EQ(event.participant_name, "part");
+            ASSERT_EQ(event.logger_name, "logger");
+            ASSERT_EQ(event.message, std::to_string(popped));
+            ++popped;
+        }
+    }
+    ASSERT_EQ(pushed, popped);
+    ASSERT_GT(ring.getPushCount(), 8u * 20u);
+    ASSERT_EQ(ring.getPushCount(), ring.getPopCount());
+}
+
+/**
+ * @brief Texts longer than the text buffer of a slot are kept completely, shorter ones in the same slot after it too
+ * @req_id <todo>
+ */
+TEST(LogRing, LongTexts)
+{
+    LogRing ring(2);
+    MonitorEvent event;
+    const std::string participant_name(100, 'p');
+    const std::string long_message(2 * LogRing::text_capacity, 'm');
+    // exactly text_capacity together still fits the buffer
+    const std::string fitting_message(LogRing::text_capacity - participant_name.size() - std::string("logger").size(), 'f');
+
+    for (size_t round = 0; round < 4; ++round)
+    {
+        ASSERT_TRUE(pushLog(ring, 1, participant_name, long_message));
+        ASSERT_TRUE(pushLog(ring, 2, participant_name, fitting_message));
+        ASSERT_TRUE(ring.tryPop(&event));
+        ASSERT_EQ(event.participant_name, participant_name);
+        ASSERT_EQ(event.logger_name, "logger");
+        ASSERT_EQ(event.message, long_message);
+        ASSERT_TRUE(ring.tryPop(&event));
+        ASSERT_EQ(event.participant_name, participant_name);
+        ASSERT_EQ(event.message, fitting_message);
+
+        // the slot of the long text holds a short one now
+        ASSERT_TRUE(pushLog(ring, 3, "short", "text"));
+        ASSERT_TRUE(ring.tryPop(&event));
+        ASSERT_EQ(event.participant_name, "short");
+        ASSERT_EQ(event.message, "text");
+        ASSERT_TRUE(pushLog(ring, 4, "", ""));
+        ASSERT_TRUE(ring.tryPop(&event));
+        ASSERT_EQ(event.participant_name, "");
+        ASSERT_EQ(event.message, "");
+    }
+}
+
+/**
+ * @brief A limit below the count of slots bounds the queued events, it is kept within 1 and the count of slots
+ * @req_id <todo>
+ */
+TEST(LogRing, LimitBelowSlotCount)
+{
+    LogRing ring(8);
+    MonitorEvent event;
+    ring.setLimit(3);
+    for (size_t round = 0; round < 10; ++round)
+    {
+        ASSERT_TRUE(pushLog(ring, 0, "part", "0"));
+        ASSERT_TRUE(pushLog(ring, 1, "part", "1"));
+        ASSERT_TRUE(pushLog(ring, 2, "part", "2"));
+        ASSERT_FALSE(pushLog(ring, 3, "part", "3"));
+        ASSERT_TRUE(ring.tryPop(&event));
+        ASSERT_EQ(event.message, "0");
+        ASSERT_TRUE(pushLog(ring, 3, "part", "3"));
+        ASSERT_FALSE(pushLog(ring, 4, "part", "4"));
+        for (const auto& expected : { "1", "2", "3" })
+        {
+            ASSERT_TRUE(ring.tryPop(&event));
+            ASSERT_EQ(event.message, expected);
+        }
+        ASSERT_FALSE(ring.tryPop(&event));
+    }
+
+    ring.setLimit(0);
+    ASSERT_TRUE(pushLog(ring, 0, "part", "0"));
+    ASSERT_FALSE(pushLog(ring, 1, "part", "1"));
+    ASSERT_TRUE(ring.tryPop(nullptr));
+
+    ring.setLimit(100);
+    for (size_t idx = 0; idx < 8; ++idx)
+    {
+        ASSERT_TRUE(pushLog(ring, 0, "part", "0"));
+    }
+    ASSERT_FALSE(pushLog(ring, 0, "part", "0"));
+}
+
+/**
+ * @brief Several producers dropping the oldest event on a full ring while the consumer takes events lose no count,
+ * every taken event is complete and the events of one producer stay in order
+ * @req_id <todo>
+ */
+TEST(LogRing, ProducersDropOldest)
+{
+    const size_t producer_count = 4;
+    const size_t events_per_producer = 20000;
+    LogRing ring(16);
+    std::atomic<size_t> dropped{ 0 };
+    std::atomic<bool> producing{ true };
+
+    std::vector<std::thread> producers;
+    for (size_t producer = 0; producer < producer_count; ++producer)
+    {
+        producers.emplace_back([&, producer]()
+        {
+            const std::string participant_name = "participant" + std::to_string(producer);
+            for (size_t idx = 0; idx < events_per_producer; ++idx)
+            {
+                while (!pushLog(ring, static_cast<timestamp_t>(idx), participant_name,
+                    participant_name + ":" + std::to_string(idx)))
+                {
+                    if (ring.tryPop(nullptr))
+                    {
+                        ++dropped;
+                    }
+                }
+            }
+        });
+    }
+
+    size_t consumed = 0;
+    std::vector<timestamp_t> last_time(producer_count, -1);
+    bool consistent = true;
+    MonitorEvent event;
+    auto consume = [&]()
+    {
+        while (ring.tryPop(&event))
+        {
+            ++consumed;
+            const size_t producer = std::stoul(event.participant_name.substr(std::string("participant").size()));
+            consistent = consistent && producer < producer_count
+                && event.message == event.participant_name + ":" + std::to_string(event.log_time)
+                && event.log_time > last_time[producer];
+            if (producer < producer_count)
+            {
+                last_time[producer] = event.log_time;
+            }
+        }
+    };
+    std::thread consumer([&]()
+    {
+        while (producing)
+        {
+            consume();
+            std::this_thread::yield();
+        }
+    });
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    producing = false;
+    consumer.join();
+    consume();
+
+    ASSERT_TRUE(consistent);
+    ASSERT_TRUE(ring.isEmpty());
+    ASSERT_EQ(ring.getPushCount(), producer_count * events_per_producer);
+    ASSERT_EQ(ring.getPopCount(), producer_count * events_per_producer);
+    ASSERT_EQ(consumed + dropped, producer_count * events_per_producer);
+}
@@ -106,6 +106,49 @@ TEST(ParticipantConfiguration, TestProxyConfigSetter)
 }
 
 
+/**
+ * @req_id <todo>
+ */
+TEST(ParticipantConfiguration, TestProxyConfigTypedAccess)
+{
+    System systm("Blackbox");
+    cTestBaseModule mod;
+    ASSERT_EQ(a_util::result::SUCCESS, mod.Create("Participant1_typed_configuration_test"));
+    systm.add(mod.GetName());
+    auto p1 = systm.getParticipant(mod.GetName());
+
+    auto config = p1.getRPCComponentProxy<fep::rpc::IRPCConfiguration>();
+    ASSERT_TRUE(static_cast<bool>(config));
+
+    auto pt = getComponent<IPropertyTree>(mod);
+    ASSERT_TRUE(pt != nullptr);
+
+    testTypedAccess(*pt, config.getInterface(), true, false, "test_bool");
+    testTypedAccess(*pt, config.getInterface(), int32_t(3456), int32_t(1), "test_int");
+    testTypedAccess(*pt, config.getInterface(), 1.5, 0.0, "test_double");
+}
+
+/**
+ * @brief It's tested that registered listeners are called on property changes until they are unregistered
+ * @req_id <todo>
+ */
+TEST(ParticipantConfiguration, TestProxyConfigPropertyListener)
+{
+    System systm("Blackbox");
+    cTestBaseModule mod;
+    ASSERT_EQ(a_util::result::SUCCESS, mod.Create("Participant1_watch_configuration_test"));
+    systm.add(mod.GetName());
+    auto p1 = systm.getParticipant(mod.GetName());
+
+    auto config = p1.getRPCComponentProxy<fep::rpc::IRPCConfiguration>();
+    ASSERT_TRUE(static_cast<bool>(config));
+
+    auto pt = getComponent<IPropertyTree>(mod);
+    ASSERT_TRUE(pt != nullptr);
+
+    testPropertyListener(*pt, config.getInterface());
+}
+
 /**
  * @req_id <todo>
  */
@@ -137,6 +180,36 @@ TEST(ParticipantConfiguration, TestProxyConfigArraySetter)
     testArraySetter(*pt, config.getInterface(), string_val_array, { "init_val", "another_val" }, "test_string");
 }
 
+/**
+ * @req_id <todo>
+ */
+TEST(ParticipantConfiguration, TestProxyConfigTypedArrayAccess)
+{
+    System systm("Blackbox");
+    cTestBaseModule mod;
+    ASSERT_EQ(a_util::result::SUCCESS, mod.Create("Participant1_typed_array_configuration_test"));
+    systm.add(mod.GetName());
+    auto p1 = systm.getParticipant(mod.GetName());
+
+    auto config = p1.getRPCComponentProxy<fep::rpc::IRPCConfiguration>();
+    ASSERT_TRUE(static_cast<bool>(config));
+
+    auto pt = getComponent<IPropertyTree>(mod);
+    ASSERT_TRUE(pt != nullptr);
+
+    //only properties that exists will be set
+    ASSERT_TRUE(fep::isOk(pt->SetPropertyValue("deeper_path.test_double_array", 0.0)));
+    auto prop = pt->GetProperty("deeper_path.test_double_array");
+    prop->AppendValue(0.0);
+
+    //the participant does not announce binary encoded arrays, so the string representation is used
+    auto props = config->getProperties("/deeper_path");
+    std::vector<double> value = { 1.5, -2.25, 1e-9 };
+    ASSERT_TRUE(fep::setPropertyValue(*props, "test_double_array", value));
+    ASSERT_EQ(props->getPropertyType("test_double_array"), fep::PropertyType<std::vector<double>>::getTypeName());
+    ASSERT_EQ(fep::getPropertyValue<std::vector<double>>(*props, "test_double_array"), value);
+}
+
 /**
  * @req_id FEPSDK-2058
  */
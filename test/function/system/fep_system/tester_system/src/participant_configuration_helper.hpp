@@ -39,6 +39,10 @@
 #include "fep_system/base/properties/property_type.h"
 #include "fep_system/base/properties/property_type_conversion.h"
 #include <fep_participant_sdk.h>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
 
 
 template<typename T>
@@ -121,6 +125,29 @@ inline void testSetter(fep::IPropertyTree& pt, fep::rpc::IRPCConfiguration& rpc_
     ASSERT_EQ(ret_value, value);
 }
 
+template<typename T>
+void testTypedAccess(fep::IPropertyTree& pt, fep::rpc::IRPCConfiguration& rpc_config, T value, T init_value, std::string propertyname)
+{
+    std::string path = "deeper_path";
+    std::string propertypath_withdots = path + "." + propertyname;
+
+    //only properties that exist will be set
+    ASSERT_TRUE(fep::isOk(pt.SetPropertyValue(propertypath_withdots.c_str(), init_value)));
+
+    auto properties_to_test = rpc_config.getProperties("/" + path);
+    ASSERT_TRUE(fep::setPropertyValue(*properties_to_test, propertyname, value));
+
+    T ret_value = init_value;
+    ASSERT_TRUE(fep::isOk(pt.GetPropertyValue(propertypath_withdots.c_str(), ret_value)));
+    ASSERT_EQ(ret_value, value);
+    ASSERT_EQ(fep::getPropertyValue<T>(*properties_to_test, propertyname, init_value), value);
+
+    //a different type will not be converted
+    std::string string_value = "unchanged";
+    ASSERT_FALSE(fep::getPropertyValue(*properties_to_test, propertyname, string_value));
+    ASSERT_EQ(string_value, "unchanged");
+}
+
 inline void testSetterExistingProperty(fep::rpc::IRPCConfiguration& rpc_config,
     const std::string& value,
     const std::string& init_value,
@@ -317,3 +344,59 @@ inline void testArraySetter(fep::IPropertyTree& pt,
     ASSERT_EQ(ret_value, value);
 }
 
+class TestPropertyListener : public fep::rpc::IPropertyChangeListener
+{
+public:
+    void onPropertyChanged(const std::string& /*participant_name*/,
+                           const std::string& property_path,
+                           const std::string& value) override
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _changes.push_back(property_path + "=" + value);
+        _changed.notify_all();
+    }
+
+    bool waitForChange(const std::string& change)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _changed.wait_for(lock, std::chrono::seconds(5), [&]()
+        {
+            return std::find(_changes.begin(), _changes.end(), change) != _changes.end();
+        });
+    }
+
+    bool hasChange(const std::string& change)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return std::find(_changes.begin(), _changes.end(), change) != _changes.end();
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _changed;
+    std::vector<std::string> _changes;
+};
+
+inline void testPropertyListener(fep::IPropertyTree& pt, fep::rpc::IRPCConfiguration& rpc_config)
+{
+    ASSERT_TRUE(fep::isOk(pt.SetPropertyValue("deeper_path.test_watch", "init")));
+
+    //both notations address the same watched property
+    TestPropertyListener listener1;
+    TestPropertyListener listener2;
+    rpc_config.registerPropertyListener("deeper_path.test_watch", listener1);
+    rpc_config.registerPropertyListener("/deeper_path/test_watch", listener2);
+    EXPECT_FALSE(listener1.hasChange("deeper_path/test_watch=init"));
+
+    ASSERT_TRUE(fep::isOk(pt.SetPropertyValue("deeper_path.test_watch", "changed")));
+    EXPECT_TRUE(listener1.waitForChange("deeper_path/test_watch=changed"));
+    EXPECT_TRUE(listener2.waitForChange("deeper_path/test_watch=changed"));
+
+    //an unregistered listener is not called anymore
+    rpc_config.unregisterPropertyListener("deeper_path.test_watch", listener1);
+    ASSERT_TRUE(fep::isOk(pt.SetPropertyValue("deeper_path.test_watch", "changed_again")));
+    EXPECT_TRUE(listener2.waitForChange("deeper_path/test_watch=changed_again"));
+    EXPECT_FALSE(listener1.hasChange("deeper_path/test_watch=changed_again"));
+
+    rpc_config.unregisterPropertyListener("/deeper_path/test_watch", listener2);
+}
@@ -108,6 +108,51 @@ TEST(ParticipantConfigurationOld, TestProxyConfigSetter)
     testSetter(*pt, config.getInterface(), string_val, "init_val", "test_string");
 }
 
+/**
+ * @req_id <todo>
+ */
+TEST(ParticipantConfigurationOld, TestProxyConfigTypedAccess)
+{
+    System systm("Blackbox");
+    cTestBaseModule mod;
+    ASSERT_EQ(a_util::result::SUCCESS, mod.Create("Participant1_typed_configuration_test"));
+    systm.add(mod.GetName());
+    auto p1 = systm.getParticipant(mod.GetName());
+
+    rpc_component<fep::rpc::IRPCConfiguration> config;
+    p1.getRPCComponentProxy("force_old_ai", fep::rpc::IRPCConfiguration::getRPCIID(), config);
+    ASSERT_TRUE(static_cast<bool>(config));
+
+    auto pt = getComponent<IPropertyTree>(mod);
+    ASSERT_TRUE(pt != nullptr);
+
+    testTypedAccess(*pt, config.getInterface(), true, false, "test_bool");
+    testTypedAccess(*pt, config.getInterface(), int32_t(3456), int32_t(1), "test_int");
+    testTypedAccess(*pt, config.getInterface(), 1.5, 0.0, "test_double");
+}
+
+/**
+ * @brief It's tested that registered listeners are called on property changes until they are unregistered
+ * @req_id <todo>
+ */
+TEST(ParticipantConfigurationOld, TestProxyConfigPropertyListener)
+{
+    System systm("Blackbox");
+    cTestBaseModule mod;
+    ASSERT_EQ(a_util::result::SUCCESS, mod.Create("Participant1_watch_configuration_test"));
+    systm.add(mod.GetName());
+    auto p1 = systm.getParticipant(mod.GetName());
+
+    rpc_component<fep::rpc::IRPCConfiguration> config;
+    p1.getRPCComponentProxy("force_old_ai", fep::rpc::IRPCConfiguration::getRPCIID(), config);
+    ASSERT_TRUE(static_cast<bool>(config));
+
+    auto pt = getComponent<IPropertyTree>(mod);
+    ASSERT_TRUE(pt != nullptr);
+
+    testPropertyListener(*pt, config.getInterface());
+}
+
 /**
  * @req_id <todo>
  */
@@ -181,3 +226,41 @@ TEST(ParticipantConfigurationOld, TestProxyConfigPropNotExistsNoCreate)
     //check if it is not created in the tree
     ASSERT_NE(prop_pointer, nullptr);
 }
+
+/**
+ * @req_id <todo>
+ */
+TEST(ParticipantConfigurationOld, TestProxyConfigCachedNode)
+{
+    System systm("blackbox_cached_node");
+    cTestBaseModule mod;
+    ASSERT_EQ(a_util::result::SUCCESS, mod.Create("Participant_cached_node_old"));
+    systm.add(mod.GetName());
+    auto p1 = systm.getParticipant(mod.GetName());
+
+    rpc_component<fep::rpc::IRPCConfiguration> config;
+    p1.getRPCComponentProxy("force_old_ai", fep::rpc::IRPCConfiguration::getRPCIID(), config);
+    ASSERT_TRUE(static_cast<bool>(config));
+
+    auto pt = getComponent<IPropertyTree>(mod);
+    ASSERT_TRUE(pt != nullptr);
+    ASSERT_TRUE(fep::isOk(pt->SetPropertyValue("deeper_path.test_int", int32_t(1))));
+
+    auto props = config->getProperties("/deeper_path");
+    ASSERT_EQ(props->getProperty("test_int"), "1");
+    ASSERT_EQ(props->getPropertyType("test_int"), fep::PropertyType<int32_t>::getTypeName());
+
+    //changes of the participant itself are visible after refresh
+    ASSERT_TRUE(fep::isOk(pt->SetPropertyValue("deeper_path.test_int", int32_t(2))));
+    ASSERT_EQ(props->getProperty("test_int"), "1");
+    fep::refreshProperties(*props);
+    ASSERT_EQ(props->getProperty("test_int"), "2");
+
+    //changes done by the node are visible immediately
+    ASSERT_TRUE(props->setProperty("test_int", "3", fep::PropertyType<int32_t>::getTypeName()));
+    ASSERT_EQ(props->getProperty("test_int"), "3");
+
+    //properties created after the node was retrieved are found
+    ASSERT_TRUE(fep::isOk(pt->SetPropertyValue("deeper_path.test_new", int32_t(4))));
+    ASSERT_EQ(props->getProperty("test_new"), "4");
+}
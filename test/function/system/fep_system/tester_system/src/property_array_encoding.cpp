@@ -0,0 +1,169 @@
+/**
+ *
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ *
+ *
+ * @remarks
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+#include "property_array_encoding.h"
+
+using namespace fep;
+
+namespace
+{
+    template<typename T>
+    void expectRoundTrip(const std::vector<T>& value)
+    {
+        const auto encoded = binary_array::encode(value);
+        ASSERT_EQ(encoded.size() % 4, 0u);
+        std::vector<T> decoded;
+        ASSERT_TRUE(binary_array::decode(encoded, decoded)) << encoded;
+        ASSERT_EQ(decoded, value);
+    }
+
+    /// the arrays of 0 to 5 elements, so every padding length is covered for each element size
+    template<typename T>
+    void expectRoundTrips(const std::vector<T>& elements)
+    {
+        for (size_t count = 0; count <= 5; ++count)
+        {
+            std::vector<T> value;
+            for (size_t idx = 0; idx < count; ++idx)
+            {
+                value.push_back(elements[idx % elements.size()]);
+            }
+            expectRoundTrip(value);
+        }
+    }
+}
+
+/**
+ * @brief The bool arrays are packed one byte per element and decoded again
+ * @req_id <todo>
+ */
+TEST(PropertyArrayEncoding, RoundTripBool)
+{
+    expectRoundTrips<bool>({ true, false, false, true });
+    ASSERT_EQ(binary_array::encode(std::vector<bool>{ true, false }), "AQA=");
+
+    // every nonzero byte is true
+    std::vector<bool> decoded;
+    ASSERT_TRUE(binary_array::decode("AP8=", decoded));
+    ASSERT_EQ(decoded, (std::vector<bool>{ false, true }));
+}
+
+/**
+ * @brief The int32 arrays are packed little endian and decoded again
+ * @req_id <todo>
+ */
+TEST(PropertyArrayEncoding, RoundTripInt32)
+{
+    expectRoundTrips<int32_t>({ 0, -1, 42, std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max() });
+    ASSERT_EQ(binary_array::encode(std::vector<int32_t>{ 1 }), "AQAAAA==");
+    ASSERT_EQ(binary_array::encode(std::vector<int32_t>{ -2, 7 }), "/v///wcAAAA=");
+}
+
+/**
+ * @brief The double arrays are packed bit exact and decoded again
+ * @req_id <todo>
+ */
+TEST(PropertyArrayEncoding, RoundTripDouble)
+{
+    expectRoundTrips<double>({ 0.0, -0.0, 1.5, -1e300, std::numeric_limits<double>::denorm_min(),
+        std::numeric_limits<double>::infinity(), std::numeric_limits<double>::lowest() });
+    ASSERT_EQ(binary_array::encode(std::vector<double>{ 1.5 }), "AAAAAAAA+D8=");
+
+    // the sign of zero and not a number survive, they do not compare equal as values
+    const std::vector<double> value{ -0.0, std::numeric_limits<double>::quiet_NaN() };
+    std::vector<double> decoded;
+    ASSERT_TRUE(binary_array::decode(binary_array::encode(value), decoded));
+    ASSERT_EQ(decoded.size(), 2u);
+    ASSERT_EQ(std::memcmp(decoded.data(), value.data(), sizeof(double) * 2), 0);
+}
+
+/**
+ * @brief The base64 coding reproduces every byte value and every length
+ * @req_id <todo>
+ */
+TEST(PropertyArrayEncoding, RoundTripBase64)
+{
+    std::string buffer;
+    for (int byte = 0; byte < 256; ++byte)
+    {
+        buffer.push_back(static_cast<char>(byte));
+    }
+    for (size_t size = 0; size <= buffer.size(); ++size)
+    {
+        const auto part = buffer.substr(0, size);
+        std::string decoded;
+        ASSERT_TRUE(binary_array::fromBase64(binary_array::toBase64(part), decoded));
+        ASSERT_EQ(decoded, part);
+    }
+}
+
+/**
+ * @brief Malformed encodings are rejected and leave the value unchanged
+ * @req_id <todo>
+ */
+TEST(PropertyArrayEncoding, RejectMalformedInput)
+{
+    std::string buffer;
+    // bad length
+    ASSERT_FALSE(binary_array::fromBase64("AQA", buffer));
+    ASSERT_FALSE(binary_array::fromBase64("AQAAA", buffer));
+    // bad characters
+    ASSERT_FALSE(binary_array::fromBase64("AQ-=", buffer));
+    ASSERT_FALSE(binary_array::fromBase64("AQ A", buffer));
+    ASSERT_FALSE(binary_array::fromBase64("AQ\xC3\xA4", buffer));
+    // bad padding: within the text, too long or not matching the last group
+    ASSERT_FALSE(binary_array::fromBase64("A=AA", buffer));
+    ASSERT_FALSE(binary_array::fromBase64("AQ==AQ==", buffer));
+    ASSERT_FALSE(binary_array::fromBase64("A===", buffer));
+    ASSERT_FALSE(binary_array::fromBase64("====", buffer));
+    // nonzero padding bits
+    ASSERT_FALSE(binary_array::fromBase64("AQB=", buffer));
+    ASSERT_FALSE(binary_array::fromBase64("AR==", buffer));
+    ASSERT_TRUE(binary_array::fromBase64("AQA=", buffer));
+    ASSERT_TRUE(binary_array::fromBase64("AQ==", buffer));
+
+    // the decoded bytes do not fill whole elements
+    const std::vector<int32_t> original{ 3 };
+    std::vector<int32_t> value = original;
+    ASSERT_FALSE(binary_array::decode("AQA=", value));
+    ASSERT_FALSE(binary_array::decode("AQAAAAE=", value));
+    std::vector<double> doubles{ 1.0 };
+    ASSERT_FALSE(binary_array::decode("AQAAAA==", doubles));
+    ASSERT_EQ(doubles, std::vector<double>{ 1.0 });
+    ASSERT_FALSE(binary_array::decode("AQB=", value));
+    ASSERT_EQ(value, original);
+
+    // a binary array type with a malformed value is not converted to the string representation
+    std::string type = binary_array::getTypeName<int32_t>();
+    std::string text = "AQA=";
+    ASSERT_FALSE(binary_array::toStringRepresentation(type, text));
+    text = binary_array::encode(std::vector<int32_t>{ 1, 2 });
+    ASSERT_TRUE(binary_array::toStringRepresentation(type, text));
+    ASSERT_EQ(type, PropertyType<std::vector<int32_t>>::getTypeName());
+}
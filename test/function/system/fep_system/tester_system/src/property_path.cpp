@@ -0,0 +1,149 @@
+/**
+ *
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ *
+ *
+ * @remarks
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include "property_path.h"
+#include "property_diff.h"
+
+using namespace fep;
+
+/**
+ * @brief Slashes separate the names, dots only if they are allowed, leading and trailing separators are dropped
+ * @req_id <todo>
+ */
+TEST(PropertyPath, ScanSeparators)
+{
+    for (const auto& text : { "Clock/MainClock", "/Clock/MainClock", "Clock/MainClock/", "/Clock/MainClock/" })
+    {
+        const auto path = PropertyPath::parse(text);
+        ASSERT_TRUE(path.isValid()) << text;
+        ASSERT_FALSE(path.isRoot()) << text;
+        ASSERT_EQ(path.toString(), "Clock/MainClock") << text;
+        ASSERT_EQ(path.toString('.'), "Clock.MainClock") << text;
+        ASSERT_EQ(path.toServicePath(), "/Clock/MainClock") << text;
+    }
+
+    // dots are names characters only for parseAny
+    ASSERT_FALSE(PropertyPath::parse("Clock.MainClock").isValid());
+    for (const auto& text : { "Clock.MainClock", ".Clock.MainClock.", "Clock/MainClock", "/Clock.MainClock/" })
+    {
+        const auto path = PropertyPath::parseAny(text);
+        ASSERT_TRUE(path.isValid()) << text;
+        ASSERT_EQ(path.toString(), "Clock/MainClock") << text;
+    }
+
+    // the names of one character and of all name characters
+    ASSERT_EQ(PropertyPath::parse("a/_/9").toString(), "a/_/9");
+    ASSERT_TRUE(PropertyPath::parse("azAZ09_").isValid());
+}
+
+/**
+ * @brief The empty path and a single separator are the root, empty names and other characters are invalid
+ * @req_id <todo>
+ */
+TEST(PropertyPath, ScanRootAndInvalidPaths)
+{
+    for (const auto& text : { "", "/" })
+    {
+        ASSERT_TRUE(PropertyPath::parse(text).isValid()) << text;
+        ASSERT_TRUE(PropertyPath::parse(text).isRoot()) << text;
+        ASSERT_EQ(PropertyPath::parse(text).toServicePath(), "/") << text;
+    }
+    ASSERT_TRUE(PropertyPath().isRoot());
+    ASSERT_TRUE(PropertyPath::parseAny(".").isRoot());
+
+    for (const auto& text : { "//", "//Clock", "Clock//MainClock", "Clock/MainClock//", "Clock-MainClock",
+                              "Clock MainClock", "Clock/\xC3\xA4" })
+    {
+        const auto path = PropertyPath::parse(text);
+        ASSERT_FALSE(path.isValid()) << text;
+        // invalid paths keep the text as given
+        ASSERT_EQ(path.toString(), text);
+        ASSERT_EQ(path.toString('.'), text);
+        ASSERT_EQ(path.toServicePath(), text);
+    }
+    ASSERT_FALSE(PropertyPath::parseAny("Clock./MainClock").isValid());
+    ASSERT_FALSE(PropertyPath::parseAny("./").isValid());
+}
+
+/**
+ * @brief Paths are equal by their names, independent of the separators they were parsed with
+ * @req_id <todo>
+ */
+TEST(PropertyPath, CompareAndAppend)
+{
+    const auto path = PropertyPath::parse("/Clock/MainClock/");
+    ASSERT_EQ(path, PropertyPath::parseAny("Clock.MainClock"));
+    ASSERT_EQ(path.getHash(), PropertyPath::parseAny("Clock.MainClock").getHash());
+    ASSERT_EQ(std::hash<PropertyPath>()(path), path.getHash());
+    ASSERT_NE(path, PropertyPath::parse("Clock/MainClock2"));
+    ASSERT_NE(PropertyPath::parse("Clock.MainClock"), PropertyPath::parseAny("Clock.MainClock"));
+
+    const auto root = PropertyPath();
+    ASSERT_EQ(root.append(path), path);
+    ASSERT_EQ(path.append(root), path);
+    ASSERT_EQ(PropertyPath::parse("Clock").append(PropertyPath::parse("/MainClock/")), path);
+}
+
+/**
+ * @brief The interner is cleared when it is full, the paths parsed before stay valid and equal to parsed again
+ * @req_id <todo>
+ */
+TEST(PropertyPath, InternerClearsWhenFull)
+{
+    const auto kept = PropertyPath::parse("/Kept/Path/");
+    const auto kept_invalid = PropertyPath::parse("Kept//Path");
+    // more texts than the interner keeps, so it is cleared at least twice
+    for (size_t idx = 0; idx < 40000; ++idx)
+    {
+        const auto text = "Filler" + std::to_string(idx);
+        const auto path = PropertyPath::parse(text);
+        ASSERT_TRUE(path.isValid());
+        ASSERT_EQ(path.toString(), text);
+    }
+    ASSERT_TRUE(kept.isValid());
+    ASSERT_EQ(kept.toString(), "Kept/Path");
+    ASSERT_EQ(kept, PropertyPath::parse("Kept/Path"));
+    ASSERT_EQ(kept.getHash(), PropertyPath::parse("Kept/Path").getHash());
+    ASSERT_FALSE(kept_invalid.isValid());
+    ASSERT_EQ(kept_invalid, PropertyPath::parse("Kept//Path"));
+    ASSERT_NE(kept, PropertyPath::parse("Filler0"));
+}
+
+/**
+ * @brief Full property paths are split into the properties node and the property name
+ * @req_id <todo>
+ */
+TEST(PropertyPath, SplitPropertyPath)
+{
+    for (const auto& text : { "Clock.MainClock.Name", "/Clock/MainClock/Name", "Clock/MainClock/Name/" })
+    {
+        const auto node_and_name = splitPropertyPath(text);
+        ASSERT_EQ(node_and_name.first, "/Clock/MainClock") << text;
+        ASSERT_EQ(node_and_name.second, "Name") << text;
+    }
+    ASSERT_EQ(splitPropertyPath("Name"), std::make_pair(std::string("/"), std::string("Name")));
+    ASSERT_EQ(splitPropertyPath("/Name/"), std::make_pair(std::string("/"), std::string("Name")));
+}
@@ -36,10 +36,18 @@
 
 #include <gtest/gtest.h>
 #include <fep_system/fep_system.h>
+#include <fep_system/event_recorder.h>
 #include <string.h>
+#include <cstdio>
+#include <fstream>
+#include <algorithm>
+#include <iterator>
+#include <chrono>
+#include <cstdlib>
 #include "fep_test_common.h"
 #include "a_util/logging.h"
 #include "a_util/process.h"
+#include "a_util/datetime.h"
 
 void addingTestParticipants(fep::System& sys)
 {
@@ -268,6 +276,37 @@ TEST(SystemLibrary, SystemWithStandaloneParticipantCanNotBeStarted)
     EXPECT_THROW(my_system.start(), std::runtime_error);
 }
 
+/**
+* @brief It's tested that the standalone mode is cached on the participant proxy until the cache is invalidated
+* @req_id <todo>
+*/
+TEST(SystemLibrary, StandaloneModeIsCachedOnTheProxy)
+{
+    const auto participant_names = std::vector<std::string>{ "participant1", "participant2" };
+    const Modules modules = createTestModules(participant_names);
+
+    fep::System my_system = fep::System("my_system");
+    EXPECT_NO_THROW(my_system.add(participant_names));
+    const auto participant = my_system.getParticipant("participant1");
+    ASSERT_FALSE(participant.isStandalone());
+
+    ASSERT_EQ(
+        modules.at("participant1")->GetPropertyTree()->SetPropertyValue(FEP_STM_STANDALONE_PATH, true),
+        a_util::result::Result());
+    /// the cached value is used until the cache is invalidated
+    ASSERT_FALSE(my_system.getParticipant("participant1").isStandalone());
+    participant.invalidateCache();
+    ASSERT_TRUE(my_system.getParticipant("participant1").isStandalone());
+    EXPECT_THROW(my_system.start(), std::runtime_error);
+
+    ASSERT_EQ(
+        modules.at("participant1")->GetPropertyTree()->SetPropertyValue(FEP_STM_STANDALONE_PATH, false),
+        a_util::result::Result());
+    participant.invalidateCache();
+    EXPECT_NO_THROW(my_system.start());
+    EXPECT_NO_THROW(my_system.stop());
+}
+
 /**
  * @brief It's tested that setPropertyValueToAll will raise an exception if setting a property fails
  * @req_id <todo>
@@ -341,6 +380,224 @@ TEST(SystemLibrary, TestExceptionSetProperty)
 }
 
 
+/**
+ * @brief It's tested that configureTiming writes the master and the client properties to the right participants
+ * @req_id <todo>
+ */
+TEST(SystemLibrary, TestConfigureTimingAppliesToAllParticipants)
+{
+    const auto participant_names = std::vector<std::string>{ "master" , "client1", "client2" };
+    const Modules modules = createTestModules(participant_names);
+
+    auto my_system = fep::System("my_system");
+    EXPECT_NO_THROW(my_system.add(participant_names));
+    EXPECT_NO_THROW(my_system.configureTiming3ClockSyncOnlyInterpolation("master", "100"));
+
+    const char* value = nullptr;
+    ASSERT_EQ(modules.at("master")->GetPropertyTree()->GetPropertyValue(FEP_CLOCKSERVICE_MAIN_CLOCK, value),
+        a_util::result::Result());
+    EXPECT_STREQ(value, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_LOCAL_SYSTEM_REAL_TIME);
+
+    for (const auto& client : { "client1", "client2" })
+    {
+        ASSERT_EQ(modules.at(client)->GetPropertyTree()->GetPropertyValue(FEP_CLOCKSERVICE_MAIN_CLOCK, value),
+            a_util::result::Result());
+        EXPECT_STREQ(value, FEP_CLOCKSERVICE_MAIN_CLOCK_VALUE_SLAVE_MASTER_ONDEMAND);
+
+        ASSERT_EQ(modules.at(client)->GetPropertyTree()->GetPropertyValue(FEP_TIMING_MASTER_PARTICIPANT, value),
+            a_util::result::Result());
+        EXPECT_STREQ(value, "master");
+    }
+}
+
+
+/**
+ * @brief It's tested that applyConfiguration only sets the properties which differ from the desired values
+ * @req_id <todo>
+ */
+TEST(SystemLibrary, TestApplyConfigurationWritesOnlyChanges)
+{
+    const auto participant_names = std::vector<std::string>{ "participant1" , "participant2" };
+    const Modules modules = createTestModules(participant_names);
+
+    auto my_system = fep::System("my_system");
+    EXPECT_NO_THROW(my_system.add(participant_names));
+
+    fep::SystemConfiguration desired;
+    for (const auto& participant_name : participant_names)
+    {
+        desired[participant_name][FEP_TIMING_MASTER_PARTICIPANT] =
+            { "participant1", fep::PropertyType<std::string>::getTypeName() };
+    }
+
+    const auto changes = my_system.applyConfiguration(desired);
+    ASSERT_EQ(changes.size(), 2u);
+
+    const char* value = nullptr;
+    ASSERT_EQ(modules.at("participant2")->GetPropertyTree()->GetPropertyValue(FEP_TIMING_MASTER_PARTICIPANT, value),
+        a_util::result::Result());
+    EXPECT_STREQ(value, "participant1");
+
+    // nothing differs anymore
+    EXPECT_TRUE(my_system.applyConfiguration(desired).empty());
+
+    // a missing property is created, even with a value equal to the empty read
+    desired["participant1"]["Custom/Empty"] = { "", fep::PropertyType<std::string>::getTypeName() };
+    const auto created = my_system.applyConfiguration(desired);
+    ASSERT_EQ(created.size(), 1u);
+    EXPECT_EQ(created.front().path, "Custom/Empty");
+    EXPECT_EQ(created.front().old_value, "");
+    ASSERT_EQ(modules.at("participant1")->GetPropertyTree()->GetPropertyValue("Custom.Empty", value),
+        a_util::result::Result());
+    EXPECT_STREQ(value, "");
+    EXPECT_TRUE(my_system.applyConfiguration(desired).empty());
+
+    // a property of another type is a change, even if the value reads the same
+    desired["participant1"]["Custom/Number"] = { "1", fep::PropertyType<int32_t>::getTypeName() };
+    ASSERT_EQ(my_system.applyConfiguration(desired).size(), 1u);
+    desired["participant1"]["Custom/Number"] = { "1.0", fep::PropertyType<double>::getTypeName() };
+    const auto retyped = my_system.applyConfiguration(desired);
+    ASSERT_EQ(retyped.size(), 1u);
+    EXPECT_EQ(retyped.front().path, "Custom/Number");
+    EXPECT_EQ(retyped.front().old_value, "1");
+    EXPECT_EQ(retyped.front().type, fep::PropertyType<double>::getTypeName());
+
+    // unknown participants are rejected before anything is read
+    desired["does_not_exist"] = desired["participant1"];
+    EXPECT_THROW(my_system.applyConfiguration(desired), std::runtime_error);
+}
+
+/**
+ * @brief It's tested that loadConfiguration applies the system and participant properties and priorities of a file
+ * and that invalid files are rejected before anything is set
+ * @req_id <todo>
+ */
+TEST(SystemLibrary, TestLoadConfiguration)
+{
+    const auto participant_names = std::vector<std::string>{ "participant1" , "participant2" };
+    const Modules modules = createTestModules(participant_names);
+
+    auto my_system = fep::System("my_system");
+    EXPECT_NO_THROW(my_system.add(participant_names));
+
+    const std::string file_path = "test_load_configuration.json";
+    {
+        std::ofstream file(file_path);
+        file << "{\n"
+            "  \"properties\": { \"" FEP_TIMING_MASTER_PARTICIPANT "\": \"participant1\" },\n"
+            "  \"participants\": {\n"
+            "    \"participant2\": {\n"
+            "      \"init_priority\": 7,\n"
+            "      \"properties\": { \"" FEP_TIMING_MASTER_PARTICIPANT "\": { \"type\": \"string\", \"value\": \"participant2\" } }\n"
+            "    }\n"
+            "  }\n"
+            "}\n";
+    }
+    std::vector<fep::PropertyChange> changes;
+    ASSERT_NO_THROW(changes = my_system.loadConfiguration(file_path));
+    EXPECT_EQ(changes.size(), 2u);
+
+    const char* value = nullptr;
+    ASSERT_EQ(modules.at("participant1")->GetPropertyTree()->GetPropertyValue(FEP_TIMING_MASTER_PARTICIPANT, value),
+        a_util::result::Result());
+    EXPECT_STREQ(value, "participant1");
+    ASSERT_EQ(modules.at("participant2")->GetPropertyTree()->GetPropertyValue(FEP_TIMING_MASTER_PARTICIPANT, value),
+        a_util::result::Result());
+    EXPECT_STREQ(value, "participant2");
+    EXPECT_EQ(my_system.getParticipant("participant2").getInitPriority(), 7);
+
+    // loading the same file again does not change anything
+    EXPECT_TRUE(my_system.loadConfiguration(file_path).empty());
+
+    // unknown participants and unknown types are rejected before anything is set
+    {
+        std::ofstream file(file_path);
+        file << "{\n"
+            "  \"properties\": { \"" FEP_TIMING_MASTER_PARTICIPANT "\": \"changed\" },\n"
+            "  \"participants\": { \"does_not_exist\": { \"properties\": { \"Node/Value\": { \"type\": \"float\", \"value\": \"1.0\" } } } }\n"
+            "}\n";
+    }
+    EXPECT_THROW(my_system.loadConfiguration(file_path), std::runtime_error);
+    ASSERT_EQ(modules.at("participant1")->GetPropertyTree()->GetPropertyValue(FEP_TIMING_MASTER_PARTICIPANT, value),
+        a_util::result::Result());
+    EXPECT_STREQ(value, "participant1");
+
+    // values not matching their type are rejected, integral numbers like 1.0 are deduced as double
+    {
+        std::ofstream file(file_path);
+        file << "{ \"properties\": { \"Node/Values\": { \"type\": \""
+            << fep::PropertyType<std::vector<bool>>::getTypeName() << "\", \"value\": [ \"x\" ] } } }\n";
+    }
+    EXPECT_THROW(my_system.loadConfiguration(file_path), std::runtime_error);
+    {
+        std::ofstream file(file_path);
+        file << "{ \"properties\": { \"Node/Value\": { \"type\": \""
+            << fep::PropertyType<int32_t>::getTypeName() << "\", \"value\": true } } }\n";
+    }
+    EXPECT_THROW(my_system.loadConfiguration(file_path), std::runtime_error);
+    {
+        std::ofstream file(file_path);
+        file << "{ \"participants\": { \"participant1\": { \"properties\": { \"Node/Factor\": 1.0 } } } }\n";
+    }
+    ASSERT_NO_THROW(my_system.loadConfiguration(file_path));
+    double factor = 0.0;
+    ASSERT_EQ(modules.at("participant1")->GetPropertyTree()->GetPropertyValue("Node.Factor", factor),
+        a_util::result::Result());
+    EXPECT_EQ(factor, 1.0);
+
+    EXPECT_THROW(my_system.loadConfiguration("does_not_exist.json"), std::runtime_error);
+    std::remove(file_path.c_str());
+}
+
+/**
+ * @brief It's tested that a snapshot contains the property trees of all participants
+ * and that restoring it sets the changed properties back
+ * @req_id <todo>
+ */
+TEST(SystemLibrary, TestConfigurationSnapshot)
+{
+    const auto participant_names = std::vector<std::string>{ "participant1" , "participant2" };
+    const Modules modules = createTestModules(participant_names);
+
+    auto my_system = fep::System("my_system");
+    EXPECT_NO_THROW(my_system.add(participant_names));
+
+    fep::SystemConfiguration snapshot;
+    ASSERT_NO_THROW(snapshot = my_system.snapshotConfiguration());
+    ASSERT_EQ(snapshot.size(), 2u);
+    std::string master_path = FEP_TIMING_MASTER_PARTICIPANT;
+    std::replace(master_path.begin(), master_path.end(), '.', '/');
+    if (master_path.at(0) == '/')
+    {
+        master_path = master_path.substr(1);
+    }
+    ASSERT_NE(snapshot["participant2"].find(master_path), snapshot["participant2"].end());
+    const auto original_master = snapshot["participant2"][master_path].value;
+
+    const std::string file_path = "test_configuration_snapshot.bin";
+    ASSERT_NO_THROW(my_system.snapshotConfiguration(file_path));
+
+    fep::SystemConfiguration desired;
+    desired["participant2"][FEP_TIMING_MASTER_PARTICIPANT] = { "changed", fep::PropertyType<std::string>::getTypeName() };
+    ASSERT_EQ(my_system.applyConfiguration(desired).size(), 1u);
+
+    std::vector<fep::PropertyChange> changes;
+    ASSERT_NO_THROW(changes = my_system.restoreConfiguration(file_path));
+    EXPECT_TRUE(std::any_of(changes.begin(), changes.end(), [&](const fep::PropertyChange& change)
+    {
+        return change.participant == "participant2" && change.path == master_path;
+    }));
+
+    const char* value = nullptr;
+    ASSERT_EQ(modules.at("participant2")->GetPropertyTree()->GetPropertyValue(FEP_TIMING_MASTER_PARTICIPANT, value),
+        a_util::result::Result());
+    EXPECT_EQ(std::string(value), original_master);
+
+    std::remove(file_path.c_str());
+    EXPECT_THROW(my_system.restoreConfiguration(file_path), std::runtime_error);
+}
+
+
 /**
  * @req_id <todo>
  */
@@ -399,6 +656,19 @@ TEST(SystemLibrary, TestConfigureSystemNOK)
             caught = true;
         }
         ASSERT_TRUE(caught);
+
+        caught = false;
+        try
+        {
+            my_sys.configureTiming2AFAP("does_not_exist");
+        }
+        catch (std::runtime_error e)
+        {
+            const std::string msg = e.what();
+            ASSERT_EQ(msg.find("participant does_not_exist within system MeinLieblingssystem not found to configure "), 0u);
+            caught = true;
+        }
+        ASSERT_TRUE(caught);
     }
 }
 
@@ -562,6 +832,591 @@ TEST(SystemLibrary, TestMonitorSystemOK)
     }
 }
 
+class SlowEventMonitor : public TestEventMonitor
+{
+public:
+    void onLog(timestamp_t log_time,
+        logging::Category category,
+        logging::Severity severity_level,
+        const std::string& participant_name,
+        const std::string& logger_name,
+        const std::string& message) override
+    {
+        a_util::system::sleepMilliseconds(200);
+        {
+            std::unique_lock<std::mutex> lk(_messages_m);
+            _messages.push_back(message);
+        }
+        TestEventMonitor::onLog(log_time, category, severity_level, participant_name, logger_name, message);
+    }
+
+    std::vector<std::string> _messages;
+
+private:
+    std::mutex _messages_m;
+};
+
+/**
+ * @req_id <todo>
+ */
+TEST(SystemLibrary, TestMonitorQueue)
+{
+    SlowEventMonitor tem;
+    {
+        fep::System my_sys("MeinLieblingssystem");
+        my_sys.setMonitoringQueue(2, fep::MonitorOverflowPolicy::drop_newest);
+        // one event per batch, so only one event is taken from the queue at a time
+        fep::MonitorBatchOptions batching;
+        batching.max_batch_size = 1;
+        my_sys.registerMonitoring(tem, fep::MonitorFilter(), batching);
+
+        // the empty system logs a warning on every start, the slow monitor must not slow down the system
+        const auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < 10; ++i)
+        {
+            my_sys.start(500);
+        }
+        ASSERT_LT(std::chrono::steady_clock::now() - begin, std::chrono::milliseconds(1000));
+
+        // the queued events are delivered before unregister returns
+        my_sys.unregisterMonitoring(tem);
+    }
+    // at most one delivered right away and two queued, the others are dropped and reported once
+    ASSERT_GE(tem._messages.size(), 3u);
+    ASSERT_LE(tem._messages.size(), 4u);
+    ASSERT_EQ(tem._messages.back(), "No participants within the current system");
+    ASSERT_NE(tem._messages[tem._messages.size() - 3].find("events for the monitor were dropped"), std::string::npos);
+}
+
+class BatchEventMonitor : public TestEventMonitor
+{
+public:
+    void onLogBatch(const std::vector<std::shared_ptr<const fep::MonitorLogRecord>>& records) override
+    {
+        {
+            std::unique_lock<std::mutex> lk(_records_m);
+            ++_batch_count;
+            _records.insert(_records.end(), records.begin(), records.end());
+        }
+        TestEventMonitor::onLogBatch(records);
+    }
+
+    size_t getBatchCount()
+    {
+        std::unique_lock<std::mutex> lk(_records_m);
+        return _batch_count;
+    }
+
+    std::vector<std::shared_ptr<const fep::MonitorLogRecord>> getRecords()
+    {
+        std::unique_lock<std::mutex> lk(_records_m);
+        return _records;
+    }
+
+private:
+    std::mutex _records_m;
+    size_t _batch_count = 0;
+    std::vector<std::shared_ptr<const fep::MonitorLogRecord>> _records;
+};
+
+/**
+ * @req_id <todo>
+ */
+TEST(SystemLibrary, TestMonitorBatch)
+{
+    BatchEventMonitor tem;
+    {
+        fep::System my_sys("MeinLieblingssystem");
+        fep::MonitorBatchOptions batching;
+        batching.window_ms = 200;
+        my_sys.registerMonitoring(tem, fep::MonitorFilter(), batching);
+
+        // the empty system logs a warning on every start, the warnings are collected within the window
+        for (int i = 0; i < 10; ++i)
+        {
+            my_sys.start(500);
+        }
+        my_sys.unregisterMonitoring(tem);
+    }
+    const auto records = tem.getRecords();
+    ASSERT_EQ(records.size(), 10u);
+    ASSERT_LT(tem.getBatchCount(), records.size());
+    for (const auto& record : records)
+    {
+        ASSERT_EQ(record->message, "No participants within the current system");
+        ASSERT_EQ(record->severity_level, logging::SEVERITY_WARNING);
+        ASSERT_EQ(record->simulation_time, -1);
+    }
+    // the default batch callback forwards every record
+    ASSERT_EQ(tem._message, "No participants within the current system");
+}
+
+/**
+ * @req_id <todo>
+ */
+TEST(SystemLibrary, TestIncidentRateLimit)
+{
+    BatchEventMonitor tem;
+    {
+        fep::System my_sys("MeinLieblingssystem");
+        fep::IncidentRateLimit limit;
+        limit.rate = 1;
+        limit.burst = 5;
+        limit.summary_interval_ms = 100;
+        my_sys.setIncidentRateLimit(limit);
+        my_sys.registerMonitoring(tem);
+        // sleep is needed to secure our callbacks are ready
+        a_util::system::sleepMilliseconds(2000);
+
+        cTestBaseModule mod1;
+        ASSERT_EQ(a_util::result::SUCCESS, mod1.Create("Participant1"));
+        my_sys.add(mod1.GetName());
+        for (int i = 0; i < 100; ++i)
+        {
+            mod1.InvokeGlobalError(42, "incident storm");
+        }
+        a_util::system::sleepMilliseconds(1000);
+        // the coalesced incidents are summarized before unregister returns
+        my_sys.unregisterMonitoring(tem);
+        mod1.Destroy();
+    }
+
+    int passed = 0;
+    int coalesced = 0;
+    for (const auto& record : tem.getRecords())
+    {
+        if (record->participant_name != "Participant1")
+        {
+            continue;
+        }
+        if (record->message == "incident storm")
+        {
+            ++passed;
+        }
+        else if (record->message.find("occurrences in") != std::string::npos)
+        {
+            ASSERT_NE(record->message.find("of incident 42"), std::string::npos);
+            coalesced += std::atoi(record->message.c_str());
+        }
+    }
+    // the burst and at most one refilled token pass, the others are coalesced
+    ASSERT_GE(passed, 5);
+    ASSERT_LE(passed, 6);
+    ASSERT_EQ(passed + coalesced, 100);
+}
+
+/**
+ * @req_id <todo>
+ */
+TEST(SystemLibrary, TestEventRecorder)
+{
+    const std::string journal_path = "test_event_recorder.fepjournal";
+    {
+        fep::EventRecorder recorder(journal_path);
+        fep::System my_sys("MeinLieblingssystem");
+        fep::MonitorBatchOptions batching;
+        batching.window_ms = 100;
+        my_sys.registerMonitoring(recorder, fep::MonitorFilter(), batching);
+
+        // the empty system logs a warning on every start
+        for (int i = 0; i < 10; ++i)
+        {
+            my_sys.start(500);
+        }
+        my_sys.unregisterMonitoring(recorder);
+        ASSERT_GE(recorder.getRecordCount(), 10u);
+    }
+
+    fep::EventJournalReader reader(journal_path);
+    ASSERT_EQ(reader.getTimeResolution(), fep::MonitorTimeResolution::microseconds);
+    fep::EventJournalFilter filter;
+    filter.severity_level = logging::SEVERITY_WARNING;
+    const auto warnings = reader.read(filter);
+    ASSERT_EQ(warnings.size(), 10u);
+    for (const auto& record : warnings)
+    {
+        ASSERT_EQ(record.type, fep::EventJournalRecord::Type::log);
+        ASSERT_EQ(record.message, "No participants within the current system");
+        ASSERT_EQ(record.logger_name, "MeinLieblingssystem");
+    }
+
+    // the time range selects the records in between
+    filter.begin_time = warnings[2].log_time;
+    filter.end_time = warnings[5].log_time;
+    const auto in_range = reader.read(filter);
+    ASSERT_GE(in_range.size(), 4u);
+    for (const auto& record : in_range)
+    {
+        ASSERT_GE(record.log_time, filter.begin_time);
+        ASSERT_LE(record.log_time, filter.end_time);
+    }
+
+    // no system log is issued by a participant
+    filter = fep::EventJournalFilter();
+    filter.participant_name = "Participant1";
+    ASSERT_TRUE(reader.read(filter).empty());
+
+    ASSERT_THROW(fep::EventJournalReader("not_existing.fepjournal"), std::runtime_error);
+    std::remove(journal_path.c_str());
+
+    // the state changes are stamped in the resolution of the logs, which is kept in the journal
+    {
+        fep::EventRecorder recorder(journal_path, fep::MonitorTimeResolution::nanoseconds);
+        fep::System my_sys("MeinLieblingssystem");
+        my_sys.setMonitoringTimeResolution(fep::MonitorTimeResolution::nanoseconds);
+        my_sys.registerMonitoring(recorder);
+        my_sys.start(500);
+        my_sys.unregisterMonitoring(recorder);
+        recorder.onStateChanged("Participant1", FS_RUNNING);
+    }
+    fep::EventJournalReader nanoseconds_reader(journal_path);
+    ASSERT_EQ(nanoseconds_reader.getTimeResolution(), fep::MonitorTimeResolution::nanoseconds);
+    const auto records = nanoseconds_reader.read();
+    ASSERT_GE(records.size(), 2u);
+    ASSERT_EQ(records.front().type, fep::EventJournalRecord::Type::log);
+    ASSERT_EQ(records.back().type, fep::EventJournalRecord::Type::state_changed);
+    ASSERT_GE(records.back().log_time, records.front().log_time);
+    ASSERT_LT(records.back().log_time - records.front().log_time, 10 * 1000 * 1000 * 1000LL);
+    std::remove(journal_path.c_str());
+}
+
+/**
+ * @req_id <todo>
+ */
+TEST(SystemLibrary, TestTransitionLatencies)
+{
+    cTestBaseModule mod1;
+    ASSERT_EQ(a_util::result::SUCCESS, mod1.Create("Participant1"));
+    fep::System my_sys("MeinLieblingssystem");
+    my_sys.add(mod1.GetName());
+
+    for (int i = 0; i < 2; ++i)
+    {
+        my_sys.start();
+        my_sys.stop();
+    }
+
+    const auto timeline = my_sys.getTransitionTimeline();
+    ASSERT_FALSE(timeline.empty());
+    ASSERT_TRUE(timeline.front().is_trigger);
+    ASSERT_EQ(timeline.front().state, FS_READY);
+    for (size_t idx = 1; idx < timeline.size(); ++idx)
+    {
+        ASSERT_LE(timeline[idx - 1].time, timeline[idx].time);
+    }
+
+    const auto latencies = my_sys.getTransitionLatencies();
+    ASSERT_EQ(latencies.size(), 3u);
+    for (const auto& latency : latencies)
+    {
+        ASSERT_EQ(latency.participant_name, "Participant1");
+        ASSERT_EQ(latency.count, 2u);
+        ASSERT_LE(latency.min, latency.p50);
+        ASSERT_LE(latency.p50, latency.p95);
+        ASSERT_LE(latency.p95, latency.p99);
+        ASSERT_LE(latency.p99, latency.max);
+    }
+
+    const std::string csv_path = "test_transition_latencies.csv";
+    my_sys.dumpTransitionLatencies(csv_path);
+    std::ifstream csv(csv_path);
+    std::string line;
+    ASSERT_TRUE(std::getline(csv, line).good());
+    ASSERT_EQ(line, "participant,transition,count,min_us,p50_us,p95_us,p99_us,max_us");
+    size_t rows = 0;
+    while (std::getline(csv, line))
+    {
+        ASSERT_EQ(line.find("Participant1,"), 0u);
+        ++rows;
+    }
+    ASSERT_EQ(rows, latencies.size());
+    csv.close();
+    std::remove(csv_path.c_str());
+
+    my_sys.clearTransitionLatencies();
+    ASSERT_TRUE(my_sys.getTransitionLatencies().empty());
+    ASSERT_TRUE(my_sys.getTransitionTimeline().empty());
+    mod1.Destroy();
+}
+
+/**
+ * @req_id <todo>
+ */
+TEST(SystemLibrary, TestRPCMetrics)
+{
+    cTestBaseModule mod1;
+    ASSERT_EQ(a_util::result::SUCCESS, mod1.Create("Participant1"));
+    fep::System my_sys("MeinLieblingssystem");
+    my_sys.add(mod1.GetName());
+
+    fep::setRPCMetricsEnabled(true);
+    fep::resetRPCMetrics();
+    my_sys.start();
+    my_sys.stop();
+    fep::setRPCMetricsEnabled(false);
+
+    const auto metrics = fep::getRPCMetrics();
+    auto trigger = std::find_if(metrics.begin(), metrics.end(), [](const fep::RPCCallMetrics& calls)
+    {
+        return calls.participant_name == "Participant1"
+            && calls.component == "automation_interface"
+            && calls.method == "TriggerEvent";
+    });
+    ASSERT_NE(trigger, metrics.end());
+    ASSERT_GT(trigger->call_count, 0u);
+    ASSERT_EQ(trigger->error_count, 0u);
+
+    for (const auto& calls : metrics)
+    {
+        ASSERT_EQ(calls.latency_histogram.size(), static_cast<size_t>(FEP_SYSTEM_RPC_LATENCY_BUCKETS));
+        uint64_t counted = 0;
+        for (const auto bucket : calls.latency_histogram)
+        {
+            counted += bucket;
+        }
+        ASSERT_EQ(counted, calls.call_count);
+        ASSERT_LE(calls.p50, calls.p95);
+        ASSERT_LE(calls.p95, calls.p99);
+        ASSERT_LE(calls.p99, calls.max_time);
+    }
+
+    fep::resetRPCMetrics();
+    my_sys.start();
+    my_sys.stop();
+    ASSERT_TRUE(fep::getRPCMetrics().empty());
+    mod1.Destroy();
+}
+
+/**
+ * @req_id <todo>
+ */
+TEST(SystemLibrary, TestTraceExport)
+{
+    cTestBaseModule mod1;
+    ASSERT_EQ(a_util::result::SUCCESS, mod1.Create("Participant1"));
+    fep::System my_sys("MeinLieblingssystem");
+    my_sys.add(mod1.GetName());
+
+    fep::clearTrace();
+    fep::setTracingEnabled(true);
+    my_sys.start();
+    my_sys.stop();
+    fep::setTracingEnabled(false);
+
+    const std::string trace_path = "test_system_trace.json";
+    fep::writeTrace(trace_path);
+    std::ifstream trace_file(trace_path);
+    const std::string trace((std::istreambuf_iterator<char>(trace_file)), std::istreambuf_iterator<char>());
+    trace_file.close();
+    ASSERT_EQ(trace.find("{\"traceEvents\":["), 0u);
+    ASSERT_NE(trace.find("\"name\":\"start\""), std::string::npos);
+    ASSERT_NE(trace.find("\"name\":\"stop\""), std::string::npos);
+    ASSERT_NE(trace.find("\"name\":\"trigger initialize\""), std::string::npos);
+    ASSERT_NE(trace.find("\"name\":\"await_state round\""), std::string::npos);
+    ASSERT_NE(trace.find("\"name\":\"resolve proxy\""), std::string::npos);
+    ASSERT_NE(trace.find("\"participant\":\"Participant1\""), std::string::npos);
+    ASSERT_EQ(trace.find("\"name\":\"shutdown\""), std::string::npos);
+
+    fep::clearTrace();
+    fep::writeTrace(trace_path);
+    std::ifstream cleared_file(trace_path);
+    const std::string cleared((std::istreambuf_iterator<char>(cleared_file)), std::istreambuf_iterator<char>());
+    cleared_file.close();
+    ASSERT_EQ(cleared.find("\"ph\":\"X\""), std::string::npos);
+    std::remove(trace_path.c_str());
+    mod1.Destroy();
+}
+
+class MembershipMonitor : public TestEventMonitor
+{
+public:
+    void onParticipantAdded(const std::string& participant_name) override
+    {
+        std::lock_guard<std::mutex> lock(_membership_mutex);
+        _added.push_back(participant_name);
+    }
+    void onParticipantRemoved(const std::string& participant_name) override
+    {
+        std::lock_guard<std::mutex> lock(_membership_mutex);
+        _removed.push_back(participant_name);
+    }
+    bool wasAdded(const std::string& participant_name)
+    {
+        std::lock_guard<std::mutex> lock(_membership_mutex);
+        return std::find(_added.begin(), _added.end(), participant_name) != _added.end();
+    }
+    bool wasRemoved(const std::string& participant_name)
+    {
+        std::lock_guard<std::mutex> lock(_membership_mutex);
+        return std::find(_removed.begin(), _removed.end(), participant_name) != _removed.end();
+    }
+
+private:
+    std::mutex _membership_mutex;
+    std::vector<std::string> _added;
+    std::vector<std::string> _removed;
+};
+
+template<typename Condition>
+bool waitUntil(Condition condition, timestamp_t timeout_ms = 10000)
+{
+    const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!condition())
+    {
+        if (std::chrono::steady_clock::now() > until)
+        {
+            return false;
+        }
+        a_util::system::sleepMilliseconds(50);
+    }
+    return true;
+}
+
+/**
+ * @req_id <todo>
+ */
+TEST(SystemLibrary, TestMembershipTracking)
+{
+    fep::System my_sys("MeinLieblingssystem");
+    MembershipMonitor monitor;
+    my_sys.registerMonitoring(monitor);
+
+    fep::MembershipTrackingOptions options;
+    options.interval_ms = 200;
+    options.missed_rounds = 2;
+    my_sys.startMembershipTracking(options);
+    ASSERT_TRUE(my_sys.isMembershipTracked());
+
+    auto hasParticipant = [&my_sys]()
+    {
+        const auto participants = my_sys.getParticipants();
+        return std::any_of(participants.begin(), participants.end(), [](const fep::ParticipantProxy& participant)
+        {
+            return participant.getName() == "Participant1";
+        });
+    };
+
+    cTestBaseModule mod1;
+    ASSERT_EQ(a_util::result::SUCCESS, mod1.Create("Participant1"));
+    ASSERT_TRUE(waitUntil(hasParticipant));
+    ASSERT_TRUE(waitUntil([&monitor]() { return monitor.wasAdded("Participant1"); }));
+
+    mod1.Destroy();
+    ASSERT_TRUE(waitUntil([&]() { return !hasParticipant(); }));
+    ASSERT_TRUE(waitUntil([&monitor]() { return monitor.wasRemoved("Participant1"); }));
+
+    my_sys.stopMembershipTracking();
+    ASSERT_FALSE(my_sys.isMembershipTracked());
+    my_sys.unregisterMonitoring(monitor);
+}
+
+class TimedEventMonitor : public TestEventMonitor
+{
+public:
+    void onLogWithSimulationTime(timestamp_t log_time,
+        timestamp_t simulation_time,
+        logging::Category category,
+        logging::Severity severity_level,
+        const std::string& participant_name,
+        const std::string& logger_name,
+        const std::string& message) override
+    {
+        _log_time = log_time;
+        _simulation_time = simulation_time;
+        TestEventMonitor::onLogWithSimulationTime(log_time, simulation_time, category, severity_level,
+            participant_name, logger_name, message);
+    }
+
+    std::atomic<timestamp_t> _log_time{ 0 };
+    std::atomic<timestamp_t> _simulation_time{ 0 };
+};
+
+/**
+ * @req_id <todo>
+ */
+TEST(SystemLibrary, TestMonitorTimeResolution)
+{
+    TimedEventMonitor tem;
+    fep::System my_sys("MeinLieblingssystem");
+    my_sys.registerMonitoring(tem);
+
+    // the empty system logs a warning on start
+    my_sys.start(500);
+    ASSERT_TRUE(tem.waitForDone());
+    const timestamp_t reference_us = a_util::datetime::getCurrentLocalDateTime().toTimestamp();
+    ASSERT_LT(std::abs(tem._log_time - reference_us), 2000000);
+    // system logs have no simulation time
+    ASSERT_EQ(tem._simulation_time.load(), -1);
+
+    my_sys.setMonitoringTimeResolution(fep::MonitorTimeResolution::nanoseconds);
+    my_sys.start(500);
+    ASSERT_TRUE(tem.waitForDone());
+    ASSERT_LT(std::abs(tem._log_time / 1000 - reference_us), 2000000);
+
+    my_sys.unregisterMonitoring(tem);
+}
+
+/**
+ * @req_id <todo>
+ */
+TEST(SystemLibrary, TestMonitorSeverityLevel)
+{
+    TestEventMonitor tem;
+    fep::System my_sys("MeinLieblingssystem");
+    my_sys.registerMonitoring(tem);
+
+    // the empty system logs a warning on start
+    my_sys.setSeverityLevel(logging::SEVERITY_WARNING);
+    my_sys.start(500);
+    ASSERT_TRUE(tem.waitForDone());
+    ASSERT_EQ(tem._severity_level, logging::SEVERITY_WARNING);
+
+    // filtered before it is queued
+    my_sys.setSeverityLevel(logging::SEVERITY_ERROR);
+    my_sys.start(500);
+    ASSERT_FALSE(tem.waitForDone(500));
+
+    my_sys.setSeverityLevel(logging::SEVERITY_DEBUG);
+    my_sys.start(500);
+    ASSERT_TRUE(tem.waitForDone());
+
+    my_sys.unregisterMonitoring(tem);
+}
+
+/**
+ * @req_id <todo>
+ */
+TEST(SystemLibrary, TestMultipleMonitors)
+{
+    TestEventMonitor all_logs;
+    TestEventMonitor errors;
+    TestEventMonitor participant_logs;
+    fep::System my_sys("MeinLieblingssystem");
+    my_sys.registerMonitoring(all_logs);
+    fep::MonitorFilter error_filter;
+    error_filter.severity_level = logging::SEVERITY_ERROR;
+    my_sys.registerMonitoring(errors, error_filter);
+    fep::MonitorFilter participant_filter;
+    participant_filter.categories = { logging::CATEGORY_PARTICIPANT };
+    my_sys.registerMonitoring(participant_logs, participant_filter);
+    ASSERT_THROW(my_sys.registerMonitoring(all_logs), std::runtime_error);
+
+    // the empty system logs a warning of the system category on start
+    my_sys.start(500);
+    ASSERT_TRUE(all_logs.waitForDone());
+    ASSERT_TRUE(all_logs._message.find("No participants within") != std::string::npos);
+    ASSERT_FALSE(errors.waitForDone(500));
+    ASSERT_FALSE(participant_logs.waitForDone(500));
+
+    // the others are still registered
+    my_sys.unregisterMonitoring(errors);
+    my_sys.unregisterMonitoring(participant_logs);
+    my_sys.start(500);
+    ASSERT_TRUE(all_logs.waitForDone());
+
+    my_sys.unregisterMonitoring(all_logs);
+}
+
 
 void print_vector(const std::vector<std::string>& strings, int number)
 {
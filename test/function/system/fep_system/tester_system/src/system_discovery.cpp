@@ -25,6 +25,8 @@
 #include <gtest/gtest.h>
 #include <fep_system/fep_system.h>
 #include <string.h>
+#include <chrono>
+#include <algorithm>
 #include "fep_test_common.h"
 #include "a_util/logging.h"
 #include "a_util/process.h"
@@ -114,3 +116,132 @@ TEST(SystemDiscovery, DiscoverSystem)
     EXPECT_EQ(participant_names,
         extractedVectorContains(discovered_names, participant_names));
 }
+
+/**
+ * @brief The discovery returns as soon as the expected participants are discovered
+ * @req_id <todo>
+ */
+TEST(SystemDiscovery, DiscoverExpectedParticipantsEarly)
+{
+    const auto participant_names = std::vector<std::string>{
+                                    MakePlatformDepName("participant1"),
+                                    MakePlatformDepName("participant2") };
+    const Modules modules = createTestModules(participant_names);
+    const auto domain_id = modules.begin()->second->GetDomainId();
+
+    fep::DiscoveryOptions options;
+    options.timeout_ms = 20000;
+    options.expected_participants = participant_names;
+    auto begin = std::chrono::steady_clock::now();
+    fep::System by_names = fep::discoverSystemOnDDS("my_system", domain_id, options);
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::milliseconds(options.timeout_ms / 2));
+    for (const auto& participant_name : participant_names)
+    {
+        EXPECT_NO_THROW(by_names.getParticipant(participant_name));
+    }
+
+    options.expected_participants.clear();
+    options.expected_count = participant_names.size();
+    begin = std::chrono::steady_clock::now();
+    fep::System by_count = fep::discoverSystemOnDDS("my_system", domain_id, options);
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::milliseconds(options.timeout_ms / 2));
+    EXPECT_GE(by_count.getParticipants().size(), participant_names.size());
+}
+
+/**
+ * @brief The discovery returns after the quiet period without new participants
+ * @req_id <todo>
+ */
+TEST(SystemDiscovery, DiscoverUntilQuietPeriod)
+{
+    const auto participant_names = std::vector<std::string>{
+                                    MakePlatformDepName("participant1"),
+                                    MakePlatformDepName("participant2") };
+    const Modules modules = createTestModules(participant_names);
+    const auto domain_id = modules.begin()->second->GetDomainId();
+
+    fep::DiscoveryOptions options;
+    options.timeout_ms = 20000;
+    options.quiet_period_ms = 1000;
+    const auto begin = std::chrono::steady_clock::now();
+    fep::System my_system = fep::discoverSystemOnDDS("my_system", domain_id, options);
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::milliseconds(options.timeout_ms / 2));
+    for (const auto& participant_name : participant_names)
+    {
+        EXPECT_NO_THROW(my_system.getParticipant(participant_name));
+    }
+}
+
+/**
+ * @brief The discovery filtered by the system name keeps participants without system affiliation
+ * @req_id <todo>
+ */
+TEST(SystemDiscovery, DiscoverBySystemNameKeepsUnaffiliatedParticipants)
+{
+    const auto participant_names = std::vector<std::string>{
+                                    MakePlatformDepName("participant1"),
+                                    MakePlatformDepName("participant2") };
+    const Modules modules = createTestModules(participant_names);
+    const auto domain_id = modules.begin()->second->GetDomainId();
+
+    fep::DiscoveryOptions options;
+    options.timeout_ms = 20000;
+    options.expected_participants = participant_names;
+    options.filter_by_system_name = true;
+    fep::System my_system = fep::discoverSystemOnDDS("my_system", domain_id, options);
+    for (const auto& participant_name : participant_names)
+    {
+        EXPECT_NO_THROW(my_system.getParticipant(participant_name));
+    }
+}
+
+/**
+ * @brief The discovery returns the metadata of the participants and keeps it cached on the proxies,
+ * resolving a component proxy afterwards does not request the RPC components again
+ * @req_id <todo>
+ */
+TEST(SystemDiscovery, DiscoverParticipantMetadata)
+{
+    const auto participant_names = std::vector<std::string>{
+                                    MakePlatformDepName("participant1"),
+                                    MakePlatformDepName("participant2") };
+    const Modules modules = createTestModules(participant_names);
+    const auto domain_id = modules.begin()->second->GetDomainId();
+
+    fep::DiscoveryOptions options;
+    options.timeout_ms = 20000;
+    options.expected_participants = participant_names;
+    std::vector<fep::DiscoveredParticipant> discovered_participants;
+    fep::System my_system = fep::discoverSystemOnDDS("my_system", domain_id, options, discovered_participants);
+
+    ASSERT_EQ(discovered_participants.size(), my_system.getParticipants().size());
+    for (const auto& participant_name : participant_names)
+    {
+        auto discovered = std::find_if(discovered_participants.begin(), discovered_participants.end(),
+            [&](const fep::DiscoveredParticipant& participant)
+            {
+                return participant.name == participant_name;
+            });
+        ASSERT_NE(discovered, discovered_participants.end());
+        EXPECT_GT(discovered->fep_version, 0.0);
+        EXPECT_NE(discovered->state, FS_UNKNOWN);
+        EXPECT_FALSE(discovered->rpc_components.empty());
+        EXPECT_FALSE(discovered->standalone);
+    }
+
+    fep::resetRPCMetrics();
+    fep::setRPCMetricsEnabled(true);
+    for (const auto& participant : my_system.getParticipants())
+    {
+        EXPECT_TRUE(static_cast<bool>(participant.getRPCComponentProxy<fep::rpc::IRPCStateMachine>()));
+        EXPECT_FALSE(participant.getMetadata().rpc_components.empty());
+    }
+    fep::setRPCMetricsEnabled(false);
+    for (const auto& calls : fep::getRPCMetrics())
+    {
+        EXPECT_NE(calls.method, "GetParticipantFEPVersion");
+        EXPECT_NE(calls.method, "getRPCComponents");
+        EXPECT_NE(calls.method, "getRPCComponentIIDs");
+    }
+    fep::resetRPCMetrics();
+}